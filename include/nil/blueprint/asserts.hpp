@@ -28,6 +28,8 @@
 
 #include <iostream>
 #include <cstring>
+#include <stdexcept>
+#include <string>
 
 #define UNREACHABLE(msg) ::nil::blueprint::unreachable((msg), __FILE__, __LINE__)
 
@@ -37,14 +39,48 @@
 
 namespace nil {
     namespace blueprint {
-        [[noreturn]] void abort_process() {
+        class assertion_failure : public std::runtime_error {
+        public:
+            using std::runtime_error::runtime_error;
+        };
+
+        // While a scope is alive on the thread, failed assertions throw assertion_failure instead of aborting,
+        // so that a long-running process fails only the request it was serving
+        class recoverable_assertions {
+        public:
+            recoverable_assertions() {
+                ++depth();
+            }
+
+            ~recoverable_assertions() {
+                --depth();
+            }
+
+            recoverable_assertions(const recoverable_assertions &) = delete;
+            recoverable_assertions &operator=(const recoverable_assertions &) = delete;
+
+            static bool active() {
+                return depth() != 0;
+            }
+
+        private:
+            static unsigned &depth() {
+                thread_local unsigned value = 0;
+                return value;
+            }
+        };
+
+        [[noreturn]] void abort_process(const std::string &msg) {
+            if (recoverable_assertions::active()) {
+                throw assertion_failure(msg);
+            }
             std::abort();
         }
 
         [[noreturn]] void unreachable(const char *msg, const char *filename, unsigned line) {
             std::cerr << "UNREACHABLE at " << filename << ":" << line << std::endl;
             std::cerr <<'\t' << msg << std::endl;
-            abort_process();
+            abort_process(std::string("UNREACHABLE at ") + filename + ":" + std::to_string(line) + ": " + msg);
         }
 
         [[noreturn]] void unreachable(const std::string &msg, const char *filename, unsigned line) {
@@ -59,7 +95,8 @@ namespace nil {
                     std::cerr << " -> " << msg;
                 }
                 std::cerr << std::endl;
-                abort_process();
+                abort_process(std::string("Assertion failed at ") + filename + ":" + std::to_string(line) + ": " +
+                              expr_str);
             }
         }
     }
@@ -0,0 +1,344 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_DAEMON_HPP
+#define CRYPTO3_ASSIGNER_DAEMON_HPP
+
+#include <atomic>
+#include <csignal>
+#include <functional>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <boost/json.hpp>
+
+#include <nil/blueprint/parser.hpp>
+
+namespace nil {
+    namespace blueprint {
+
+        namespace detail {
+            inline volatile std::sig_atomic_t daemon_interrupted = 0;
+
+            inline void interrupt_daemon(int) {
+                daemon_interrupted = 1;
+            }
+        }    // namespace detail
+
+        // Keeps parsed and prepared modules between the requests coming over a Unix domain socket.
+        // Every request is a single line with a JSON object:
+        //   {"circuit": "<loaded name>", "input": [...] | "input_file": "<path>" | "binary_input_file": "<path>",
+        //    "output": "<prefix>"}
+        // and gets a single line response:
+        //   {"status": "ok", "files": [...]} or {"status": "error", "error": "<message>"}
+        // Artifacts are written by the user callback, which gets the parser with the tables of the request.
+        // Inputs which don't match the signature of the circuit and failed assertions of the evaluation get
+        // an error response, the daemon keeps serving. Requests longer than the limit are rejected without buffering
+        template<typename BlueprintFieldType, typename ArithmetizationParams>
+        class assigner_daemon {
+        public:
+            using parser_type = parser<BlueprintFieldType, ArithmetizationParams, false>;
+            using writer_type = std::function<bool(const parser_type &assigner, const std::string &output_prefix,
+                                                   std::vector<std::string> &files, std::string &error)>;
+
+            assigner_daemon(long stack_size, std::uint32_t max_num_provers, const std::string &policy, writer_type writer) :
+                stack_size(stack_size), max_num_provers(max_num_provers), policy(policy), writer(std::move(writer)) {}
+
+            bool load(const std::string &name, const char *ir_file) {
+                auto assigner = std::make_unique<parser_type>(stack_size, false, max_num_provers, policy);
+                assigner->set_pre_optimization(pre_optimization);
+                std::unique_ptr<llvm::Module> module = assigner->parseIRFile(ir_file);
+                try {
+                    recoverable_assertions recoverable;
+                    if (module == nullptr || !assigner->prepare(*module)) {
+                        return false;
+                    }
+                } catch (const assertion_failure &failure) {
+                    std::cerr << "Can't prepare " << ir_file << ": " << failure.what() << std::endl;
+                    return false;
+                }
+                circuits[name] = loaded_circuit {std::move(assigner), std::move(module)};
+                return true;
+            }
+
+            // Serve the requests until stop() is called or the process gets SIGINT or SIGTERM, see run_assigner_daemon.
+            // Requests are evaluated one by one, the parsers are not thread safe
+            bool serve(const std::string &socket_path) {
+                sockaddr_un address {};
+                if (socket_path.size() >= sizeof(address.sun_path)) {
+                    std::cerr << "Socket path is too long: " << socket_path << std::endl;
+                    return false;
+                }
+                address.sun_family = AF_UNIX;
+                std::copy(socket_path.begin(), socket_path.end(), address.sun_path);
+
+                int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+                if (listener < 0) {
+                    std::cerr << "Can't create socket" << std::endl;
+                    return false;
+                }
+                ::unlink(socket_path.c_str());
+                if (::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 ||
+                    ::listen(listener, 16) < 0) {
+                    std::cerr << "Can't listen on " << socket_path << std::endl;
+                    ::close(listener);
+                    return false;
+                }
+
+                running = true;
+                while (serving()) {
+                    int connection = ::accept(listener, nullptr, nullptr);
+                    if (connection < 0) {
+                        continue;
+                    }
+                    serve_connection(connection);
+                    ::close(connection);
+                }
+                ::close(listener);
+                ::unlink(socket_path.c_str());
+                return true;
+            }
+
+            void stop() {
+                running = false;
+            }
+
+            void set_max_request_size(std::size_t size) {
+                max_request_size = size;
+            }
+
+            // Applies to the circuits loaded afterwards, see run_pre_optimization
+            void set_pre_optimization(bool enabled) {
+                pre_optimization = enabled;
+            }
+
+            std::string handle_request(const std::string &request) {
+                boost::json::error_code ec;
+                boost::json::value request_value = boost::json::parse(request, ec);
+                if (ec || !request_value.is_object()) {
+                    return error_response("Request must be a JSON object");
+                }
+                const boost::json::object &request_object = request_value.as_object();
+
+                const boost::json::value *name = request_object.if_contains("circuit");
+                if (name == nullptr || !name->is_string()) {
+                    return error_response("Circuit name is not set");
+                }
+                auto circuit_it = circuits.find(std::string(name->as_string()));
+                if (circuit_it == circuits.end()) {
+                    return error_response("Circuit is not loaded: " + std::string(name->as_string()));
+                }
+
+                std::unique_ptr<binary_input> binary;
+                boost::json::value input_value;
+                if (const boost::json::value *binary_file = request_object.if_contains("binary_input_file")) {
+                    if (!binary_file->is_string()) {
+                        return error_response("Input file must be a string");
+                    }
+                    binary = std::make_unique<binary_input>(std::string(binary_file->as_string()));
+                    if (!binary->get_error().empty()) {
+                        return error_response(binary->get_error());
+                    }
+                } else if (const boost::json::value *input = request_object.if_contains("input")) {
+                    input_value = *input;
+                } else if (const boost::json::value *input_file = request_object.if_contains("input_file")) {
+                    if (!input_file->is_string()) {
+                        return error_response("Input file must be a string");
+                    }
+                    std::ifstream input_stream(std::string(input_file->as_string()));
+                    if (!input_stream.is_open()) {
+                        return error_response("Can't open input file " + std::string(input_file->as_string()));
+                    }
+                    std::string input_str((std::istreambuf_iterator<char>(input_stream)), std::istreambuf_iterator<char>());
+                    input_value = boost::json::parse(input_str, ec);
+                    if (ec) {
+                        return error_response("Input file is not a valid JSON");
+                    }
+                }
+                if (binary == nullptr && !input_value.is_array()) {
+                    return error_response("Input must be a JSON array");
+                }
+                loaded_circuit &loaded = circuit_it->second;
+
+                std::string output_prefix;
+                if (const boost::json::value *output = request_object.if_contains("output")) {
+                    if (!output->is_string()) {
+                        return error_response("Output prefix must be a string");
+                    }
+                    output_prefix = std::string(output->as_string());
+                }
+
+                std::vector<std::string> files;
+                std::string error;
+                try {
+                    recoverable_assertions recoverable;
+                    bool evaluated = binary != nullptr ? loaded.assigner->evaluate(*loaded.module, *binary)
+                                                       : loaded.assigner->evaluate(*loaded.module, input_value.as_array());
+                    if (!evaluated) {
+                        const std::string &input_error = loaded.assigner->get_input_error();
+                        return error_response(input_error.empty() ? "Evaluation failed"
+                                                                  : "Public input does not match the circuit signature: " +
+                                                                        input_error);
+                    }
+                    if (!writer(*loaded.assigner, output_prefix, files, error)) {
+                        return error_response(error.empty() ? "Can't write the artifacts" : error);
+                    }
+                } catch (const assertion_failure &failure) {
+                    // The parser starts over on the next evaluation, the request is failed alone
+                    return error_response(std::string("Evaluation failed: ") + failure.what());
+                }
+
+                boost::json::object response;
+                response["status"] = "ok";
+                boost::json::array files_array;
+                for (const std::string &file : files) {
+                    files_array.emplace_back(file);
+                }
+                response["files"] = std::move(files_array);
+                return boost::json::serialize(response);
+            }
+
+        private:
+            struct loaded_circuit {
+                std::unique_ptr<parser_type> assigner;
+                std::unique_ptr<llvm::Module> module;
+            };
+
+            void serve_connection(int connection) {
+                std::string buffer;
+                char chunk[4096];
+                // The rest of a too long request is dropped up to its end of line
+                bool skipping = false;
+                while (serving()) {
+                    ssize_t received = ::read(connection, chunk, sizeof(chunk));
+                    if (received <= 0) {
+                        return;
+                    }
+                    buffer.append(chunk, received);
+                    std::size_t line_end;
+                    while ((line_end = buffer.find('\n')) != std::string::npos) {
+                        std::string response;
+                        if (skipping) {
+                            skipping = false;
+                        } else {
+                            response = handle_request(buffer.substr(0, line_end)) + "\n";
+                        }
+                        buffer.erase(0, line_end + 1);
+                        if (!send_all(connection, response)) {
+                            return;
+                        }
+                    }
+                    if (buffer.size() > max_request_size) {
+                        buffer.clear();
+                        if (!skipping) {
+                            skipping = true;
+                            std::string response = error_response("Request is longer than " +
+                                                                  std::to_string(max_request_size) + " bytes") + "\n";
+                            if (!send_all(connection, response)) {
+                                return;
+                            }
+                        }
+                    }
+                }
+            }
+
+            bool serving() const {
+                return running && detail::daemon_interrupted == 0;
+            }
+
+            static bool send_all(int connection, const std::string &data) {
+                std::size_t sent = 0;
+                while (sent < data.size()) {
+                    ssize_t res = ::write(connection, data.data() + sent, data.size() - sent);
+                    if (res <= 0) {
+                        return false;
+                    }
+                    sent += res;
+                }
+                return true;
+            }
+
+            static std::string error_response(const std::string &error) {
+                boost::json::object response;
+                response["status"] = "error";
+                response["error"] = error;
+                return boost::json::serialize(response);
+            }
+
+            long stack_size;
+            std::uint32_t max_num_provers;
+            std::string policy;
+            writer_type writer;
+            std::map<std::string, loaded_circuit> circuits;
+            std::atomic<bool> running = false;
+            std::size_t max_request_size = 64 << 20;
+            bool pre_optimization = false;
+        };
+
+        // Entry point of the daemon mode. Circuits are given as "<name>=<ir file>", the requests are served
+        // on the socket until SIGINT or SIGTERM
+        template<typename BlueprintFieldType, typename ArithmetizationParams>
+        int run_assigner_daemon(const std::string &socket_path, const std::vector<std::string> &circuits,
+                                long stack_size, std::uint32_t max_num_provers, const std::string &policy,
+                                bool pre_optimization,
+                                typename assigner_daemon<BlueprintFieldType, ArithmetizationParams>::writer_type writer) {
+            assigner_daemon<BlueprintFieldType, ArithmetizationParams> daemon(stack_size, max_num_provers, policy,
+                                                                              std::move(writer));
+            daemon.set_pre_optimization(pre_optimization);
+            for (const std::string &circuit : circuits) {
+                std::size_t separator = circuit.find('=');
+                if (separator == std::string::npos || separator == 0) {
+                    std::cerr << "Circuit must be given as <name>=<ir file>: " << circuit << std::endl;
+                    return 1;
+                }
+                if (!daemon.load(circuit.substr(0, separator), circuit.substr(separator + 1).c_str())) {
+                    std::cerr << "Can't load circuit " << circuit << std::endl;
+                    return 1;
+                }
+            }
+
+            // Without SA_RESTART the blocking accept and read return on the signal
+            struct sigaction action {};
+            action.sa_handler = detail::interrupt_daemon;
+            sigemptyset(&action.sa_mask);
+            detail::daemon_interrupted = 0;
+            ::sigaction(SIGINT, &action, nullptr);
+            ::sigaction(SIGTERM, &action, nullptr);
+
+            return daemon.serve(socket_path) ? 0 : 1;
+        }
+
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_DAEMON_HPP
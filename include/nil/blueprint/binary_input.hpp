@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_BINARY_INPUT_HPP
+#define CRYPTO3_ASSIGNER_BINARY_INPUT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nil {
+    namespace blueprint {
+        // Binary counterpart of the JSON input, the values follow the circuit signature.
+        // All the numbers are little-endian 64-bit words:
+        //   header:           8 bytes of binary_input::magic, number of values
+        //   integer:          ceil(bitness / 64) words, the least significant first
+        //   field element:    ceil(store size / 8) words, the least significant first
+        //   curve point:      two base field elements, ceil(store size / 16) words each
+        //   vector:           number of elements, the elements
+        //   array and struct: number of elements, the elements
+        //   string:           number of bytes, the bytes without '\0'
+        // There is no value for a StructRet argument, just like in the JSON input.
+        // The file is mapped into memory and read in place
+        class binary_input {
+        public:
+            static constexpr char magic[8] = {'Z', 'K', 'L', 'L', 'V', 'M', 'I', '1'};
+
+            explicit binary_input(const std::string &path) {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    error = "can't open the input file " + path;
+                    return;
+                }
+                struct stat file_stat;
+                if (::fstat(fd, &file_stat) != 0) {
+                    error = "can't get the size of the input file " + path;
+                    ::close(fd);
+                    return;
+                }
+                size = file_stat.st_size;
+                if (size != 0) {
+                    void *mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (mapped == MAP_FAILED) {
+                        error = "can't map the input file " + path;
+                        size = 0;
+                    } else {
+                        data = static_cast<const std::uint8_t *>(mapped);
+                        ::madvise(mapped, size, MADV_SEQUENTIAL);
+                        owned = true;
+                    }
+                }
+                ::close(fd);
+            }
+
+            // The input which is already in memory, the buffer must outlive the object
+            binary_input(const std::uint8_t *data, std::size_t size) : data(data), size(size) {
+            }
+
+            binary_input(const binary_input &) = delete;
+            binary_input &operator=(const binary_input &) = delete;
+
+            ~binary_input() {
+                if (owned) {
+                    ::munmap(const_cast<std::uint8_t *>(data), size);
+                }
+            }
+
+            bool read_header(std::uint64_t &values_amount) {
+                const std::uint8_t *header = read_bytes(sizeof(magic));
+                if (header == nullptr || std::memcmp(header, magic, sizeof(magic)) != 0) {
+                    if (error.empty()) {
+                        error = "the input is not in the binary input format";
+                    }
+                    return false;
+                }
+                return read_word(values_amount);
+            }
+
+            bool read_word(std::uint64_t &value) {
+                const std::uint8_t *bytes = read_bytes(8);
+                if (bytes == nullptr) {
+                    return false;
+                }
+                value = load_word(bytes);
+                return true;
+            }
+
+            // Returns nullptr if the input is too short
+            const std::uint8_t *read_bytes(std::size_t amount) {
+                if (size - position < amount) {
+                    if (error.empty()) {
+                        error = "unexpected end of the binary input";
+                    }
+                    return nullptr;
+                }
+                const std::uint8_t *res = data + position;
+                position += amount;
+                return res;
+            }
+
+            static std::uint64_t load_word(const std::uint8_t *bytes) {
+                std::uint64_t res = 0;
+                for (std::size_t i = 0; i < 8; i++) {
+                    res |= std::uint64_t(bytes[i]) << (8 * i);
+                }
+                return res;
+            }
+
+            bool at_end() const {
+                return position == size;
+            }
+
+            const std::string &get_error() const {
+                return error;
+            }
+
+        private:
+            const std::uint8_t *data = nullptr;
+            std::size_t size = 0;
+            std::size_t position = 0;
+            bool owned = false;
+            std::string error;
+        };
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_BINARY_INPUT_HPP
@@ -35,6 +35,7 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 
 namespace nil {
     namespace blueprint {
@@ -47,6 +48,7 @@ namespace nil {
                 circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
                 assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                     &assignment,
+                detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
                 std::uint32_t start_row,
                 std::size_t &public_input_idx) {
 
@@ -61,8 +63,8 @@ namespace nil {
             instance_input.input[0] = x;
             instance_input.input[1] = y;
 
-            components::generate_circuit(component_instance, bp, assignment, instance_input, start_row);
-            return components::generate_assignments(component_instance, assignment, instance_input, start_row).output;
+            detail::generate_circuit(component_instance, bp, assignment, context, instance_input, start_row);
+            return detail::generate_assignments(component_instance, assignment, context, instance_input, start_row).output;
         }
 
     }    // namespace blueprint
@@ -35,6 +35,7 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 
 namespace nil {
     namespace blueprint {
@@ -49,6 +50,7 @@ namespace nil {
                 circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
                 assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+                detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
                 std::uint32_t start_row,
                 std::size_t &public_input_idx) {
 
@@ -59,14 +61,14 @@ namespace nil {
             switch (p) {
                 case llvm::CmpInst::ICMP_EQ: {
                     eq_component_type component_instance = eq_component_type({0, 1, 2, 3, 4}, {0}, {0}, false);
-                    components::generate_circuit(component_instance, bp, assignment, {x, y}, start_row);
-                    return components::generate_assignments(component_instance, assignment, {x, y}, start_row).output;
+                    detail::generate_circuit(component_instance, bp, assignment, context, {x, y}, start_row);
+                    return detail::generate_assignments(component_instance, assignment, context, {x, y}, start_row).output;
                     break;
                 }
                 case llvm::CmpInst::ICMP_NE:{
                     eq_component_type component_instance = eq_component_type({0, 1, 2, 3, 4}, {0}, {0}, true);
-                    components::generate_circuit(component_instance, bp, assignment, {x, y}, start_row);
-                    return components::generate_assignments(component_instance, assignment, {x, y}, start_row).output;
+                    detail::generate_circuit(component_instance, bp, assignment, context, {x, y}, start_row);
+                    return detail::generate_assignments(component_instance, assignment, context, {x, y}, start_row).output;
                     break;
                 }
                 default:
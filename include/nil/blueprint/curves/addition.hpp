@@ -45,6 +45,8 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 #include <nil/blueprint/policy/policy_manager.hpp>
 
 namespace nil {
@@ -56,33 +58,33 @@ namespace nil {
                 crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>,
                 CurveType>::result_type
                 handle_native_curve_unified_addition_component(
-                    llvm::Value *operand0, llvm::Value *operand1,
-                    typename std::map<const llvm::Value *, std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
+                    std::uint32_t operand0, std::uint32_t operand1,
+                    value_storage<std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
                     circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
                     assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                         &assignment,
+                    detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
                     std::uint32_t start_row) {
 
                 using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
 
                 using ArithmetizationType = crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>;
                 using component_type = components::unified_addition<ArithmetizationType, CurveType>;
-                const auto p = PolicyManager::get_parameters(ManifestReader<component_type, ArithmetizationParams>::get_witness(0));
-                component_type component_instance(p.witness, ManifestReader<component_type, ArithmetizationParams>::get_constants(), ManifestReader<component_type, ArithmetizationParams>::get_public_inputs());
+                const component_type &component_instance = ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0));
 
                 struct var_ec_point {
                     var X;
                     var Y;
                 };
 
-                var_ec_point P = {vectors[operand0][0], vectors[operand0][1]};
-                var_ec_point Q = {vectors[operand1][0], vectors[operand1][1]};
+                var_ec_point P = {vectors.at_slot(operand0)[0], vectors.at_slot(operand0)[1]};
+                var_ec_point Q = {vectors.at_slot(operand1)[0], vectors.at_slot(operand1)[1]};
 
                 typename component_type::input_type addition_input = {{P.X, P.Y}, {Q.X, Q.Y}};
 
-                components::generate_circuit(component_instance, bp, assignment, addition_input, start_row);
-                return components::generate_assignments(
-                            component_instance, assignment, addition_input, start_row);
+                detail::generate_circuit(component_instance, bp, assignment, context, addition_input, start_row);
+                return detail::generate_assignments(
+                            component_instance, assignment, context, addition_input, start_row);
             }
 
             template<typename BlueprintFieldType, typename ArithmetizationParams, typename CurveType, typename Ed25519Type>
@@ -92,11 +94,12 @@ namespace nil {
                 Ed25519Type,
                 basic_non_native_policy<BlueprintFieldType>>::result_type
                 handle_non_native_curve_addition_component(
-                    llvm::Value *operand0, llvm::Value *operand1,
-                    typename std::map<const llvm::Value *, std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
+                    std::uint32_t operand0, std::uint32_t operand1,
+                    value_storage<std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
                     circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
                     assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                         &assignment,
+                    detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
                     std::uint32_t start_row) {
 
                 using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
@@ -104,8 +107,7 @@ namespace nil {
                 using ArithmetizationType = crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>;
                 using component_type = components::complete_addition<ArithmetizationType, CurveType,
                             Ed25519Type, basic_non_native_policy<BlueprintFieldType>>;
-                const auto p = PolicyManager::get_parameters(ManifestReader<component_type, ArithmetizationParams>::get_witness(0));
-                component_type component_instance(p.witness, ManifestReader<component_type, ArithmetizationParams>::get_constants(), ManifestReader<component_type, ArithmetizationParams>::get_public_inputs());
+                const component_type &component_instance = ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0));
 
                 using non_native_policy_type = basic_non_native_policy<BlueprintFieldType>;
 
@@ -116,44 +118,46 @@ namespace nil {
 
                 var_ec_point P = {
                     {
-                        vectors[operand0][0],
-                        vectors[operand0][1],
-                        vectors[operand0][2],
-                        vectors[operand0][3]
+                        vectors.at_slot(operand0)[0],
+                        vectors.at_slot(operand0)[1],
+                        vectors.at_slot(operand0)[2],
+                        vectors.at_slot(operand0)[3]
                     }, {
-                        vectors[operand0][4],
-                        vectors[operand0][5],
-                        vectors[operand0][6],
-                        vectors[operand0][7]}};
+                        vectors.at_slot(operand0)[4],
+                        vectors.at_slot(operand0)[5],
+                        vectors.at_slot(operand0)[6],
+                        vectors.at_slot(operand0)[7]}};
 
                 var_ec_point Q = {
                     {
-                        vectors[operand1][0],
-                        vectors[operand1][1],
-                        vectors[operand1][2],
-                        vectors[operand1][3]
+                        vectors.at_slot(operand1)[0],
+                        vectors.at_slot(operand1)[1],
+                        vectors.at_slot(operand1)[2],
+                        vectors.at_slot(operand1)[3]
                     }, {
-                        vectors[operand1][4],
-                        vectors[operand1][5],
-                        vectors[operand1][6],
-                        vectors[operand1][7]}};
+                        vectors.at_slot(operand1)[4],
+                        vectors.at_slot(operand1)[5],
+                        vectors.at_slot(operand1)[6],
+                        vectors.at_slot(operand1)[7]}};
 
                 typename component_type::input_type addition_input = {{P.X, P.Y}, {Q.X, Q.Y}};
 
-                components::generate_circuit(component_instance, bp, assignment, addition_input, start_row);
-                return components::generate_assignments(
-                            component_instance, assignment, addition_input, start_row);
+                detail::generate_circuit(component_instance, bp, assignment, context, addition_input, start_row);
+                return detail::generate_assignments(
+                            component_instance, assignment, context, addition_input, start_row);
             }
         }    // namespace detail
 
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_curve_addition_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
             using non_native_policy_type = basic_non_native_policy<BlueprintFieldType>;
 
@@ -176,12 +180,12 @@ namespace nil {
                         using component_type = components::unified_addition<ArithmetizationType, operating_curve_type>;
                         typename component_type::result_type res =
                             detail::handle_native_curve_unified_addition_component<BlueprintFieldType, ArithmetizationParams, operating_curve_type>(
-                                operand0, operand1, frame.vectors, bp, assignment, start_row);
+                                op.operands[0], op.operands[1], frame.vectors, bp, assignment, context, start_row);
                         std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> res_vector = {res.X, res.Y};
                         if (next_prover) {
-                            frame.vectors[inst] = save_shared_var(assignment, res_vector);
+                            frame.vectors.at_slot(op.result) = save_shared_var(assignment, res_vector);
                         } else {
-                            frame.vectors[inst] = res_vector;
+                            frame.vectors.at_slot(op.result) = res_vector;
                         }
                     } else {
                         UNREACHABLE("non-native pallas is undefined");
@@ -219,7 +223,7 @@ namespace nil {
                             operating_curve_type, basic_non_native_policy<BlueprintFieldType>>;
                         typename component_type::result_type res =
                             detail::handle_non_native_curve_addition_component<BlueprintFieldType, ArithmetizationParams, pallas_curve_type, operating_curve_type>(
-                                operand0, operand1, frame.vectors, bp, assignment, start_row);
+                                op.operands[0], op.operands[1], frame.vectors, bp, assignment, context, start_row);
                         std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> res_vector = {
                             res.output.x[0],
                             res.output.x[1],
@@ -229,11 +233,11 @@ namespace nil {
                             res.output.y[1],
                             res.output.y[2],
                             res.output.y[3]};
-                        frame.vectors[inst] = res_vector;
+                        frame.vectors.at_slot(op.result) = res_vector;
                         if (next_prover) {
-                            frame.vectors[inst] = save_shared_var(assignment, res_vector);
+                            frame.vectors.at_slot(op.result) = save_shared_var(assignment, res_vector);
                         } else {
-                            frame.vectors[inst] = res_vector;
+                            frame.vectors.at_slot(op.result) = res_vector;
                         }
                     }
 
@@ -28,26 +28,28 @@
 #define CRYPTO3_ASSIGNER_NIL_BLUEPRINT_CURVE_INIT_HPP
 
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
 
 namespace nil {
     namespace blueprint {
         template<typename VarType, typename BlueprintFieldType>
-        void handle_curve_init(const llvm::CallInst *inst, stack_frame<VarType> &frame) {
+        void handle_curve_init(const decoded_instruction &op, stack_frame<VarType> &frame) {
+            const llvm::Instruction *inst = op.inst;
             ASSERT(inst->getOperand(0)->getType() == inst->getOperand(1)->getType());
             ASSERT(inst->getOperand(0)->getType()->isFieldTy());
 
             std::size_t arg_num = field_arg_num<BlueprintFieldType>(inst->getOperand(0)->getType());
             if (arg_num == 1) {
-                VarType x = frame.scalars[inst->getOperand(0)];
-                VarType y = frame.scalars[inst->getOperand(1)];
-                frame.vectors[inst] = {x, y};
+                VarType x = frame.scalars.at_slot(op.operands[0]);
+                VarType y = frame.scalars.at_slot(op.operands[1]);
+                frame.vectors.at_slot(op.result) = {x, y};
             }
             else {
-                ASSERT(frame.vectors[inst->getOperand(0)].size() == frame.vectors[inst->getOperand(1)].size());
-                std::vector<VarType> vect0 = frame.vectors[inst->getOperand(0)];
-                std::vector<VarType> vect1 = frame.vectors[inst->getOperand(1)];
+                ASSERT(frame.vectors.at_slot(op.operands[0]).size() == frame.vectors.at_slot(op.operands[1]).size());
+                std::vector<VarType> vect0 = frame.vectors.at_slot(op.operands[0]);
+                std::vector<VarType> vect1 = frame.vectors.at_slot(op.operands[1]);
                 vect0.insert(vect0.end(), vect1.begin(), vect1.end());
-                frame.vectors[inst] = vect0;
+                frame.vectors.at_slot(op.result) = vect0;
             }
         }
 
@@ -45,6 +45,8 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 #include <nil/blueprint/policy/policy_manager.hpp>
 
 namespace nil {
@@ -56,11 +58,12 @@ namespace nil {
                 crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>,
                 CurveType>::result_type
                 handle_native_curve_non_native_scalar_multiplication_component(
-                    llvm::Value *operand_curve, llvm::Value *operand_field,
-                    typename std::map<const llvm::Value *, std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
+                    std::uint32_t operand_curve, std::uint32_t operand_field,
+                    value_storage<std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
                     circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
                     assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                         &assignment,
+                    detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
                     std::uint32_t start_row) {
 
                 using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
@@ -68,21 +71,20 @@ namespace nil {
                 using ArithmetizationType = crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>;
                 using component_type = components::curve_element_variable_base_scalar_mul<
                     ArithmetizationType,CurveType>;
-                const auto p = PolicyManager::get_parameters(ManifestReader<component_type, ArithmetizationParams>::get_witness(0));
-                component_type component_instance(p.witness, ManifestReader<component_type, ArithmetizationParams>::get_constants(), ManifestReader<component_type, ArithmetizationParams>::get_public_inputs());
+                const component_type &component_instance = ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0));
 
                 struct var_ec_point {
                     var X;
                     var Y;
                 };
 
-                var_ec_point T = {vectors[operand_curve][0], vectors[operand_curve][1]};
-                std::vector<var> b = {vectors[operand_field][0], vectors[operand_field][1]};
+                var_ec_point T = {vectors.at_slot(operand_curve)[0], vectors.at_slot(operand_curve)[1]};
+                std::vector<var> b = {vectors.at_slot(operand_field)[0], vectors.at_slot(operand_field)[1]};
 
                 typename component_type::input_type addition_input = {{T.X, T.Y}, b[0], b[1]};
 
-                components::generate_circuit(component_instance, bp, assignment, addition_input, start_row);
-                return components::generate_assignments(component_instance, assignment, addition_input, start_row);
+                detail::generate_circuit(component_instance, bp, assignment, context, addition_input, start_row);
+                return detail::generate_assignments(component_instance, assignment, context, addition_input, start_row);
             }
 
             template<typename BlueprintFieldType, typename ArithmetizationParams, typename CurveType, typename Ed25519Type>
@@ -92,13 +94,14 @@ namespace nil {
                 Ed25519Type,
                 basic_non_native_policy<BlueprintFieldType>>::result_type
                 handle_non_native_curve_native_scalar_multiplication_component(
-                    llvm::Value *operand_curve,
-                    llvm::Value *operand_field,
-                    typename std::map<const llvm::Value *, std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
-                    typename std::map<const llvm::Value *, crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
+                    std::uint32_t operand_curve,
+                    std::uint32_t operand_field,
+                    value_storage<std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
+                    value_storage<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
                     circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
                     assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                         &assignment,
+                    detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
                     std::uint32_t start_row) {
 
                 using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
@@ -106,8 +109,7 @@ namespace nil {
                 using ArithmetizationType = crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>;
                 using component_type = components::variable_base_multiplication<ArithmetizationType, CurveType,
                             Ed25519Type, basic_non_native_policy<BlueprintFieldType>>;
-                const auto p = PolicyManager::get_parameters(ManifestReader<component_type, ArithmetizationParams>::get_witness(0, 253));
-                component_type component_instance(p.witness, ManifestReader<component_type, ArithmetizationParams>::get_constants(), ManifestReader<component_type, ArithmetizationParams>::get_public_inputs(), 253, nil::blueprint::components::bit_shift_mode::RIGHT);
+                const component_type &component_instance = ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0, 253), 253, nil::blueprint::components::bit_shift_mode::RIGHT);
 
                 using non_native_policy_type = basic_non_native_policy<BlueprintFieldType>;
 
@@ -117,34 +119,36 @@ namespace nil {
                 };
 
                 var_ec_point T = {
-                    {vectors[operand_curve][0],
-                     vectors[operand_curve][1],
-                     vectors[operand_curve][2],
-                     vectors[operand_curve][3]},
+                    {vectors.at_slot(operand_curve)[0],
+                     vectors.at_slot(operand_curve)[1],
+                     vectors.at_slot(operand_curve)[2],
+                     vectors.at_slot(operand_curve)[3]},
                     {
-                     vectors[operand_curve][4],
-                     vectors[operand_curve][5],
-                     vectors[operand_curve][6],
-                     vectors[operand_curve][7]}};
+                     vectors.at_slot(operand_curve)[4],
+                     vectors.at_slot(operand_curve)[5],
+                     vectors.at_slot(operand_curve)[6],
+                     vectors.at_slot(operand_curve)[7]}};
 
-                var b = variables[operand_field];
+                var b = variables.at_slot(operand_field);
 
                 typename component_type::input_type addition_input = {{T.X, T.Y}, b};
 
-                components::generate_circuit(component_instance, bp, assignment, addition_input, start_row);
-                return components::generate_assignments(component_instance, assignment, addition_input, start_row);
+                detail::generate_circuit(component_instance, bp, assignment, context, addition_input, start_row);
+                return detail::generate_assignments(component_instance, assignment, context, addition_input, start_row);
             }
 
         }    // namespace detail
 
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_curve_multiplication_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
             using non_native_policy_type = basic_non_native_policy<BlueprintFieldType>;
 
@@ -192,13 +196,13 @@ namespace nil {
                                 ArithmetizationType, operating_curve_type>;
                         typename component_type::result_type res =
                             detail::handle_native_curve_non_native_scalar_multiplication_component<BlueprintFieldType, ArithmetizationParams, operating_curve_type>(
-                                operand_curve, operand_field, frame.vectors, bp, assignment, start_row);
+                                op.operands[curve_nr], op.operands[field_nr], frame.vectors, bp, assignment, context, start_row);
                         std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> res_vector = {res.X, res.Y};
                         if (next_prover) {
                             std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> res_vector;
-                            frame.vectors[inst] = save_shared_var(assignment, res_vector);
+                            frame.vectors.at_slot(op.result) = save_shared_var(assignment, res_vector);
                         } else {
-                            frame.vectors[inst] = res_vector;
+                            frame.vectors.at_slot(op.result) = res_vector;
                         }
                     } else {
                         UNREACHABLE("non-native pallas multiplication is not implemented");
@@ -226,12 +230,13 @@ namespace nil {
                             operating_curve_type, basic_non_native_policy<BlueprintFieldType>>;
                         typename component_type::result_type res =
                             detail::handle_non_native_curve_native_scalar_multiplication_component<BlueprintFieldType, ArithmetizationParams, pallas_curve_type, operating_curve_type>(
-                                operand_curve,
-                                operand_field,
+                                op.operands[curve_nr],
+                                op.operands[field_nr],
                                 frame.vectors,
                                 frame.scalars,
                                 bp,
                                 assignment,
+                                context,
                                 start_row);
 
                         std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> res_vector =
@@ -247,10 +252,10 @@ namespace nil {
                         };
 
                         if (next_prover) {
-                            frame.vectors[inst] = save_shared_var(assignment, std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>(
+                            frame.vectors.at_slot(op.result) = save_shared_var(assignment, std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>(
                                     std::begin(res_vector), std::end(res_vector)));
                         } else {
-                            frame.vectors[inst] = std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>(
+                            frame.vectors.at_slot(op.result) = std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>(
                                     std::begin(res_vector), std::end(res_vector));
                         }
                     }
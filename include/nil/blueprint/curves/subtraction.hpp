@@ -43,6 +43,7 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
 
 namespace nil {
     namespace blueprint {
@@ -51,12 +52,14 @@ namespace nil {
 
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_curve_subtraction_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
             using non_native_policy_type = basic_non_native_policy<BlueprintFieldType>;
 
@@ -0,0 +1,470 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_DECODED_PROGRAM_HPP
+#define CRYPTO3_ASSIGNER_DECODED_PROGRAM_HPP
+
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include "llvm/IR/Type.h"
+
+#include <nil/blueprint/asserts.hpp>
+#include <nil/blueprint/stack.hpp>
+
+namespace nil {
+    namespace blueprint {
+
+        // Handler of an instruction, resolved once from its opcode and operand types
+        enum class op_handler : std::uint8_t {
+            INTEGER_ADDITION,
+            FIELD_ADDITION,
+            CURVE_ADDITION,
+            INTEGER_SUBTRACTION,
+            FIELD_SUBTRACTION,
+            CURVE_SUBTRACTION,
+            INTEGER_MULTIPLICATION,
+            FIELD_MULTIPLICATION,
+            CURVE_MULTIPLICATION,
+            INTEGER_DIVISION,
+            INTEGER_QUOTIENT,
+            INTEGER_REMAINDER,
+            FIELD_DIVISION,
+            SHIFT_LEFT,
+            SHIFT_RIGHT,
+            CALL,
+            INTRINSIC,
+            SCALAR_CMP,
+            POINTER_CMP,
+            VECTOR_CMP,
+            CURVE_CMP,
+            SELECT,
+            AND,
+            OR,
+            XOR,
+            BR,
+            PHI,
+            SWITCH,
+            INSERT_ELEMENT,
+            EXTRACT_ELEMENT,
+            ALLOCA,
+            GEP,
+            LOAD,
+            STORE,
+            INSERT_VALUE,
+            EXTRACT_VALUE,
+            INDIRECT_BR,
+            PTR_TO_INT,
+            INT_TO_PTR,
+            TRUNC,
+            EXTENSION,
+            RET,
+            // The instruction has no effect
+            NOP,
+            // The instruction can't be evaluated, the error is reported and evaluation stops
+            INVALID,
+            // The instruction is not supported, evaluation aborts
+            UNSUPPORTED,
+        };
+
+        struct decoded_instruction {
+            const llvm::Instruction *inst;
+            op_handler handler;
+            llvm::Intrinsic::ID intrinsic_id;
+            // Frame slots of the operands (in the order of the operand list) and of the result
+            std::vector<std::uint32_t> operands;
+            std::uint32_t result;
+            // Index of the next non-debug instruction of the block
+            std::size_t next;
+            // Indices of the successor blocks for terminators and of the callee entry for calls.
+            // For conditional branches the false destination goes first, like in the operand list,
+            // for switches the default destination goes first and then the cases in their order
+            std::vector<std::size_t> successors;
+            // Prover index from zk_multi_prover metadata of the instruction and of the next one
+            std::optional<std::uint32_t> prover_idx;
+            std::optional<std::uint32_t> next_prover_idx;
+            std::string error;
+        };
+
+        // Flat array of decoded instructions of all the functions in the module.
+        // It is built once before the evaluation, so the interpreter loop only follows indices
+        // and dispatches on the precomputed handler
+        class decoded_program {
+        public:
+            static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+            // Returns false if an instruction has a malformed prover annotation
+            bool decode(const llvm::Module &module) {
+                instructions.clear();
+                block_starts.clear();
+                numberings.clear();
+
+                // Number all the instructions first, so that forward references can be resolved
+                std::unordered_map<const llvm::Instruction *, std::size_t> indices;
+                for (const llvm::Function &function : module) {
+                    value_numbering &numbering = numberings[&function];
+                    for (const llvm::Argument &arg : function.args()) {
+                        numbering.add(&arg);
+                    }
+                    for (const llvm::BasicBlock &bb : function) {
+                        block_starts[&bb] = instructions.size();
+                        for (const llvm::Instruction &inst : bb) {
+                            indices[&inst] = instructions.size();
+                            decoded_instruction op {&inst, op_handler::NOP, llvm::Intrinsic::not_intrinsic, {}, 0, npos, {}, {}, {}, {}};
+                            if (!extract_prover_idx(&inst, op.prover_idx)) {
+                                return false;
+                            }
+                            for (const llvm::Value *operand : inst.operand_values()) {
+                                op.operands.push_back(number_value(numbering, operand));
+                            }
+                            op.result = numbering.add(&inst);
+                            instructions.push_back(std::move(op));
+                        }
+                    }
+                }
+
+                for (decoded_instruction &op : instructions) {
+                    const llvm::Instruction *next_inst = op.inst->getNextNonDebugInstruction();
+                    if (next_inst != nullptr) {
+                        op.next = indices[next_inst];
+                        op.next_prover_idx = instructions[op.next].prover_idx;
+                    }
+                    decode_instruction(op);
+                }
+                return true;
+            }
+
+            const decoded_instruction &operator[](std::size_t idx) const {
+                return instructions[idx];
+            }
+
+            std::size_t get_block_start(const llvm::BasicBlock *bb) const {
+                auto it = block_starts.find(bb);
+                ASSERT_MSG(it != block_starts.end(), "Basic block is not decoded");
+                return it->second;
+            }
+
+            std::size_t get_entry(const llvm::Function &function) const {
+                return get_block_start(&function.front());
+            }
+
+            std::size_t size() const {
+                return instructions.size();
+            }
+
+            const value_numbering &get_numbering(const llvm::Function &function) const {
+                auto it = numberings.find(&function);
+                ASSERT_MSG(it != numberings.end(), "Function is not decoded");
+                return it->second;
+            }
+
+        private:
+            static bool extract_prover_idx(const llvm::Instruction *inst, std::optional<std::uint32_t> &prover_idx) {
+                const llvm::MDNode* metaDataNode = inst->getMetadata("zk_multi_prover");
+                if (!metaDataNode) {
+                    return true;
+                }
+                const llvm::MDString *MDS = llvm::dyn_cast<llvm::MDString>(metaDataNode->getOperand(0));
+                long long idx;
+                if (MDS == nullptr || MDS->getString().trim().getAsInteger(10, idx) || idx < 0 ||
+                    idx >= std::numeric_limits<std::uint32_t>::max()) {
+                    std::cerr << "Invalid zk_multi_prover index";
+                    if (MDS != nullptr) {
+                        std::cerr << " \"" << MDS->getString().str() << "\"";
+                    }
+                    std::cerr << std::endl;
+                    return false;
+                }
+                prover_idx = static_cast<std::uint32_t>(idx);
+                return true;
+            }
+
+            // Constant expressions are evaluated operand by operand, so their operands need slots too
+            static std::uint32_t number_value(value_numbering &numbering, const llvm::Value *value) {
+                if (auto expr = llvm::dyn_cast<llvm::ConstantExpr>(value)) {
+                    for (const llvm::Value *expr_operand : expr->operand_values()) {
+                        number_value(numbering, expr_operand);
+                    }
+                }
+                return numbering.add(value);
+            }
+
+            void decode_instruction(decoded_instruction &op) {
+                const llvm::Instruction *inst = op.inst;
+                switch (inst->getOpcode()) {
+                    case llvm::Instruction::Add: {
+                        llvm::Type *op0_type = inst->getOperand(0)->getType();
+                        llvm::Type *op1_type = inst->getOperand(1)->getType();
+                        if (op0_type->isIntegerTy()) {
+                            op.handler = op_handler::INTEGER_ADDITION;
+                        } else if (op0_type->isFieldTy() && op1_type->isFieldTy()) {
+                            op.handler = op_handler::FIELD_ADDITION;
+                        } else if (op0_type->isCurveTy() && op1_type->isCurveTy()) {
+                            op.handler = op_handler::CURVE_ADDITION;
+                        } else {
+                            unsupported(op, "curve + scalar is undefined");
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::Sub: {
+                        llvm::Type *op0_type = inst->getOperand(0)->getType();
+                        llvm::Type *op1_type = inst->getOperand(1)->getType();
+                        if (op0_type->isIntegerTy()) {
+                            op.handler = op_handler::INTEGER_SUBTRACTION;
+                        } else if (op0_type->isFieldTy() && op1_type->isFieldTy()) {
+                            op.handler = op_handler::FIELD_SUBTRACTION;
+                        } else if (op0_type->isCurveTy() && op1_type->isCurveTy()) {
+                            op.handler = op_handler::CURVE_SUBTRACTION;
+                        } else {
+                            unsupported(op, "curve - scalar is undefined");
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::Mul: {
+                        llvm::Type *op0_type = inst->getOperand(0)->getType();
+                        llvm::Type *op1_type = inst->getOperand(1)->getType();
+                        if (op0_type->isIntegerTy()) {
+                            op.handler = op_handler::INTEGER_MULTIPLICATION;
+                        } else if (op0_type->isFieldTy() && op1_type->isFieldTy()) {
+                            op.handler = op_handler::FIELD_MULTIPLICATION;
+                        } else {
+                            unsupported(op, "Mul opcode is defined only for fieldTy and integerTy");
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::CMul: {
+                        llvm::Type *op0_type = inst->getOperand(0)->getType();
+                        llvm::Type *op1_type = inst->getOperand(1)->getType();
+                        if ((op0_type->isCurveTy() && op1_type->isFieldTy()) ||
+                            (op1_type->isCurveTy() && op0_type->isFieldTy())) {
+                            op.handler = op_handler::CURVE_MULTIPLICATION;
+                        } else {
+                            unsupported(op, "cmul opcode is defined only for curveTy * fieldTy");
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::UDiv: {
+                        llvm::Type *op0_type = inst->getOperand(0)->getType();
+                        llvm::Type *op1_type = inst->getOperand(1)->getType();
+                        if (op0_type->isIntegerTy() && op1_type->isIntegerTy()) {
+                            op.handler = op_handler::INTEGER_QUOTIENT;
+                        } else if (op0_type->isFieldTy() && op1_type->isFieldTy()) {
+                            op.handler = op_handler::FIELD_DIVISION;
+                        } else {
+                            unsupported(op, "UDiv opcode is defined only for integerTy and fieldTy");
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::URem: {
+                        if (inst->getOperand(0)->getType()->isIntegerTy() && inst->getOperand(1)->getType()->isIntegerTy()) {
+                            op.handler = op_handler::INTEGER_REMAINDER;
+                        } else {
+                            unsupported(op, "URem opcode is defined only for integerTy");
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::Shl: {
+                        if (inst->getOperand(0)->getType()->isIntegerTy() && inst->getOperand(1)->getType()->isIntegerTy()) {
+                            op.handler = op_handler::SHIFT_LEFT;
+                        } else {
+                            unsupported(op, "shl opcode is defined only for integerTy");
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::LShr: {
+                        if (inst->getOperand(0)->getType()->isIntegerTy() && inst->getOperand(1)->getType()->isIntegerTy()) {
+                            op.handler = op_handler::SHIFT_RIGHT;
+                        } else {
+                            unsupported(op, "LShr opcode is defined only for integerTy");
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::SDiv: {
+                        llvm::Type *op0_type = inst->getOperand(0)->getType();
+                        llvm::Type *op1_type = inst->getOperand(1)->getType();
+                        if (op0_type->isIntegerTy()) {
+                            op.handler = op_handler::INTEGER_DIVISION;
+                        } else if (op0_type->isFieldTy() && op1_type->isFieldTy()) {
+                            op.handler = op_handler::FIELD_DIVISION;
+                        } else {
+                            op.handler = op_handler::NOP;
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::Call: {
+                        auto *call_inst = llvm::cast<llvm::CallInst>(inst);
+                        auto *fun = call_inst->getCalledFunction();
+                        if (fun == nullptr) {
+                            invalid(op, "Unresolved call");
+                            break;
+                        }
+                        if (fun->isIntrinsic()) {
+                            op.handler = op_handler::INTRINSIC;
+                            op.intrinsic_id = fun->getIntrinsicID();
+                            break;
+                        }
+                        if (fun->empty()) {
+                            unsupported(op, "Function " + fun->getName().str() + " has no implementation.");
+                            break;
+                        }
+                        op.handler = op_handler::CALL;
+                        op.successors.push_back(get_entry(*fun));
+                        break;
+                    }
+                    case llvm::Instruction::ICmp: {
+                        llvm::Type *cmp_type = inst->getOperand(0)->getType();
+                        if (cmp_type->isIntegerTy() || cmp_type->isFieldTy()) {
+                            op.handler = op_handler::SCALAR_CMP;
+                        } else if (cmp_type->isPointerTy()) {
+                            op.handler = op_handler::POINTER_CMP;
+                        } else if (cmp_type->isVectorTy()) {
+                            op.handler = op_handler::VECTOR_CMP;
+                        } else if (cmp_type->isCurveTy()) {
+                            op.handler = op_handler::CURVE_CMP;
+                        } else {
+                            unsupported(op, "Unsupported icmp operand type");
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::Select:
+                        op.handler = op_handler::SELECT;
+                        break;
+                    case llvm::Instruction::And:
+                        op.handler = op_handler::AND;
+                        break;
+                    case llvm::Instruction::Or:
+                        op.handler = op_handler::OR;
+                        break;
+                    case llvm::Instruction::Xor:
+                        op.handler = op_handler::XOR;
+                        break;
+                    case llvm::Instruction::Br: {
+                        op.handler = op_handler::BR;
+                        if (inst->getNumOperands() != 1) {
+                            ASSERT(inst->getNumOperands() == 3);
+                            op.successors.push_back(get_block_start(llvm::cast<llvm::BasicBlock>(inst->getOperand(1))));
+                            op.successors.push_back(get_block_start(llvm::cast<llvm::BasicBlock>(inst->getOperand(2))));
+                        } else {
+                            op.successors.push_back(get_block_start(llvm::cast<llvm::BasicBlock>(inst->getOperand(0))));
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::PHI:
+                        op.handler = op_handler::PHI;
+                        break;
+                    case llvm::Instruction::Switch: {
+                        op.handler = op_handler::SWITCH;
+                        auto switch_inst = llvm::cast<llvm::SwitchInst>(inst);
+                        op.successors.push_back(get_block_start(switch_inst->getDefaultDest()));
+                        for (auto Case : switch_inst->cases()) {
+                            op.successors.push_back(get_block_start(Case.getCaseSuccessor()));
+                        }
+                        break;
+                    }
+                    case llvm::Instruction::InsertElement: {
+                        if (!llvm::isa<llvm::ConstantInt>(inst->getOperand(2))) {
+                            invalid(op, "Only constant indices for a vector are supported");
+                            break;
+                        }
+                        op.handler = op_handler::INSERT_ELEMENT;
+                        break;
+                    }
+                    case llvm::Instruction::ExtractElement: {
+                        if (!llvm::isa<llvm::ConstantInt>(inst->getOperand(1))) {
+                            invalid(op, "Only constant indices for a vector are supported");
+                            break;
+                        }
+                        op.handler = op_handler::EXTRACT_ELEMENT;
+                        break;
+                    }
+                    case llvm::Instruction::Alloca:
+                        op.handler = op_handler::ALLOCA;
+                        break;
+                    case llvm::Instruction::GetElementPtr:
+                        op.handler = op_handler::GEP;
+                        break;
+                    case llvm::Instruction::Load:
+                        op.handler = op_handler::LOAD;
+                        break;
+                    case llvm::Instruction::Store:
+                        op.handler = op_handler::STORE;
+                        break;
+                    case llvm::Instruction::InsertValue:
+                        op.handler = op_handler::INSERT_VALUE;
+                        break;
+                    case llvm::Instruction::ExtractValue:
+                        op.handler = op_handler::EXTRACT_VALUE;
+                        break;
+                    case llvm::Instruction::IndirectBr:
+                        op.handler = op_handler::INDIRECT_BR;
+                        break;
+                    case llvm::Instruction::PtrToInt:
+                        op.handler = op_handler::PTR_TO_INT;
+                        break;
+                    case llvm::Instruction::IntToPtr:
+                        op.handler = op_handler::INT_TO_PTR;
+                        break;
+                    case llvm::Instruction::Trunc:
+                        op.handler = op_handler::TRUNC;
+                        break;
+                    case llvm::Instruction::SExt:
+                    case llvm::Instruction::ZExt:
+                        op.handler = op_handler::EXTENSION;
+                        break;
+                    case llvm::Instruction::Ret:
+                        op.handler = op_handler::RET;
+                        break;
+                    default:
+                        unsupported(op, std::string("Unsupported opcode type: ") + inst->getOpcodeName());
+                }
+            }
+
+            static void invalid(decoded_instruction &op, const std::string &error) {
+                op.handler = op_handler::INVALID;
+                op.error = error;
+            }
+
+            static void unsupported(decoded_instruction &op, const std::string &error) {
+                op.handler = op_handler::UNSUPPORTED;
+                op.error = error;
+            }
+
+            std::vector<decoded_instruction> instructions;
+            std::unordered_map<const llvm::BasicBlock *, std::size_t> block_starts;
+            std::unordered_map<const llvm::Function *, value_numbering> numberings;
+        };
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_DECODED_PROGRAM_HPP
@@ -0,0 +1,340 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_DEFERRED_ASSIGNMENTS_HPP
+#define CRYPTO3_ASSIGNER_DEFERRED_ASSIGNMENTS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <nil/blueprint/blueprint/plonk/assignment_proxy.hpp>
+
+#include <nil/blueprint/asserts.hpp>
+
+namespace nil {
+    namespace blueprint {
+        namespace detail {
+
+            struct assignment_task {
+                std::function<void()> run;
+                std::uint32_t start_row;
+                std::uint32_t end_row;
+                std::vector<std::size_t> dependents;
+                std::size_t unresolved;
+            };
+
+            // Runs a graph of tasks, a task is started once all the tasks it depends on are done.
+            // Every worker has its own queue: the tasks a worker unblocks are pushed to its queue and taken
+            // from its back, idle workers steal from the front of the other queues
+            class assignment_thread_pool {
+                struct work_queue {
+                    std::mutex mutex;
+                    std::deque<std::size_t> tasks;
+                };
+
+            public:
+                assignment_thread_pool(std::size_t threads_amount) : queues(threads_amount) {
+                    for (std::size_t i = 0; i < threads_amount; i++) {
+                        workers.emplace_back([this, i]() { worker_loop(i); });
+                    }
+                }
+
+                ~assignment_thread_pool() {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        stopping = true;
+                    }
+                    work_available.notify_all();
+                    for (std::thread &worker : workers) {
+                        worker.join();
+                    }
+                }
+
+                std::size_t size() const {
+                    return workers.size();
+                }
+
+                void run(std::vector<assignment_task> &graph) {
+                    if (graph.empty()) {
+                        return;
+                    }
+                    tasks = &graph;
+                    unresolved.reset(new std::atomic<std::size_t>[graph.size()]);
+                    remaining = graph.size();
+                    for (std::size_t i = 0; i < graph.size(); i++) {
+                        unresolved[i] = graph[i].unresolved;
+                    }
+                    // All the counters are set before the first task is started
+                    std::size_t next_queue = 0;
+                    for (std::size_t i = 0; i < graph.size(); i++) {
+                        if (graph[i].unresolved == 0) {
+                            push(next_queue++ % queues.size(), i);
+                        }
+                    }
+                    std::unique_lock<std::mutex> lock(mutex);
+                    all_done.wait(lock, [this]() { return remaining == 0; });
+                    tasks = nullptr;
+                }
+
+            private:
+                void push(std::size_t queue_idx, std::size_t task_idx) {
+                    {
+                        std::lock_guard<std::mutex> lock(queues[queue_idx].mutex);
+                        queues[queue_idx].tasks.push_back(task_idx);
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        ++queued;
+                    }
+                    work_available.notify_one();
+                }
+
+                bool pop(std::size_t self, std::size_t &task_idx) {
+                    {
+                        std::lock_guard<std::mutex> lock(queues[self].mutex);
+                        if (!queues[self].tasks.empty()) {
+                            task_idx = queues[self].tasks.back();
+                            queues[self].tasks.pop_back();
+                            return true;
+                        }
+                    }
+                    for (std::size_t i = 1; i < queues.size(); i++) {
+                        work_queue &victim = queues[(self + i) % queues.size()];
+                        std::lock_guard<std::mutex> lock(victim.mutex);
+                        if (!victim.tasks.empty()) {
+                            task_idx = victim.tasks.front();
+                            victim.tasks.pop_front();
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                void worker_loop(std::size_t self) {
+                    while (true) {
+                        std::size_t idx;
+                        if (!pop(self, idx)) {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            work_available.wait(lock, [this]() { return stopping || queued > 0; });
+                            if (stopping) {
+                                return;
+                            }
+                            continue;
+                        }
+                        --queued;
+                        assignment_task &task = (*tasks)[idx];
+                        task.run();
+
+                        for (std::size_t dependent : task.dependents) {
+                            if (--unresolved[dependent] == 0) {
+                                push(self, dependent);
+                            }
+                        }
+                        if (--remaining == 0) {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            all_done.notify_all();
+                        }
+                    }
+                }
+
+                std::vector<std::thread> workers;
+                std::vector<work_queue> queues;
+                std::mutex mutex;
+                std::condition_variable work_available;
+                std::condition_variable all_done;
+                std::vector<assignment_task> *tasks = nullptr;
+                std::unique_ptr<std::atomic<std::size_t>[]> unresolved;
+                std::atomic<std::size_t> remaining {0};
+                std::atomic<std::size_t> queued {0};
+                bool stopping = false;
+            };
+
+            // Two-phase witness generation. While the program is interpreted, components get their rows reserved
+            // and their generate_assignments calls are recorded together with the components they take input from.
+            // Recorded calls are run on the thread pool when the interpreter needs a value from the reserved rows
+            // or when the evaluation is over. Every component writes only its own rows, so the table is the same
+            // as with the sequential generation. In the lazy mode there is no pool, the calls are run in order
+            // only when their values are needed and the rest can be discarded.
+            // The scheduler is owned by the parser, components reach it through the generation context
+            template<typename ArithmetizationType>
+            class AssignmentScheduler {
+            public:
+                using var = crypto3::zk::snark::plonk_variable<typename ArithmetizationType::field_type::value_type>;
+
+                AssignmentScheduler() = default;
+                AssignmentScheduler(const AssignmentScheduler &) = delete;
+                AssignmentScheduler &operator=(const AssignmentScheduler &) = delete;
+
+                void start(std::shared_ptr<assignment<ArithmetizationType>> table, assignment_thread_pool *thread_pool,
+                           bool lazy = false) {
+                    tasks.clear();
+                    task_assignments.clear();
+                    assignment_table = std::move(table);
+                    pool = thread_pool;
+                    deferring = false;
+                    enabled = lazy || pool != nullptr;
+                }
+
+                bool is_enabled() const {
+                    return enabled;
+                }
+
+                void set_deferring(bool value) {
+                    deferring = value && is_enabled();
+                }
+
+                bool is_deferring() const {
+                    return deferring;
+                }
+
+                bool has_pending() const {
+                    return !tasks.empty();
+                }
+
+                bool is_pending(const var &v) const {
+                    return !tasks.empty() && v.type == var::column_type::witness &&
+                           std::uint32_t(v.rotation) >= tasks.front().start_row;
+                }
+
+                template<typename ComponentType>
+                typename ComponentType::result_type defer(const ComponentType &component_instance,
+                                                          assignment_proxy<ArithmetizationType> &assignment,
+                                                          const typename ComponentType::input_type &instance_input,
+                                                          const std::uint32_t start_row) {
+                    const std::uint32_t end_row = start_row + component_instance.rows_amount;
+                    // Size the columns up front, so that the next component is placed after this one and
+                    // the columns are not resized while the components are filled concurrently
+                    if (end_row != start_row) {
+                        for (std::size_t i = 0; i < component_instance.witness_amount(); i++) {
+                            assignment_table->witness(component_instance.W(i), end_row - 1);
+                        }
+                    }
+
+                    std::size_t idx = tasks.size();
+                    typename ComponentType::input_type input = instance_input;
+                    std::vector<std::size_t> dependencies;
+                    for (var &v : input.all_vars()) {
+                        if (!is_pending(v)) {
+                            continue;
+                        }
+                        auto it = std::upper_bound(tasks.begin(), tasks.end(), std::uint32_t(v.rotation),
+                                                   [](std::uint32_t row, const assignment_task &task) {
+                                                       return row < task.start_row;
+                                                   });
+                        ASSERT(it != tasks.begin());
+                        std::size_t dependency = std::distance(tasks.begin(), it) - 1;
+                        if (std::uint32_t(v.rotation) < tasks[dependency].end_row) {
+                            dependencies.push_back(dependency);
+                        }
+                    }
+                    std::sort(dependencies.begin(), dependencies.end());
+                    dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+                    for (std::size_t dependency : dependencies) {
+                        tasks[dependency].dependents.push_back(idx);
+                    }
+
+                    // Every task fills the table through its own proxy, which records the rows it uses
+                    task_assignments.push_back(
+                        std::make_unique<assignment_proxy<ArithmetizationType>>(assignment_table, assignment.get_id()));
+                    assignment_proxy<ArithmetizationType> *task_assignment = task_assignments.back().get();
+                    tasks.push_back({[component_instance, input, start_row, task_assignment]() {
+                                         components::generate_assignments(component_instance, *task_assignment, input,
+                                                                          start_row);
+                                     },
+                                     start_row, end_row, {}, dependencies.size()});
+                    return typename ComponentType::result_type(component_instance, start_row);
+                }
+
+                // Run the recorded calls, the rows they used are recorded on the proxies of their provers
+                void flush(std::vector<assignment_proxy<ArithmetizationType>> &assignments) {
+                    if (tasks.empty()) {
+                        return;
+                    }
+                    if (tasks.size() == 1 || pool == nullptr) {
+                        for (assignment_task &task : tasks) {
+                            task.run();
+                        }
+                    } else {
+                        pool->run(tasks);
+                    }
+                    for (const auto &task_assignment : task_assignments) {
+                        mark_used_rows(find_prover(assignments, task_assignment->get_id()),
+                                       task_assignment->get_used_rows());
+                    }
+                    tasks.clear();
+                    task_assignments.clear();
+                }
+
+                // Drop the recorded calls, their rows stay reserved for the components
+                void discard(std::vector<assignment_proxy<ArithmetizationType>> &assignments) {
+                    for (std::size_t i = 0; i < tasks.size(); i++) {
+                        std::set<std::uint32_t> rows;
+                        for (std::uint32_t row = tasks[i].start_row; row < tasks[i].end_row; row++) {
+                            rows.insert(row);
+                        }
+                        mark_used_rows(find_prover(assignments, task_assignments[i]->get_id()), rows);
+                    }
+                    tasks.clear();
+                    task_assignments.clear();
+                }
+
+            private:
+                static assignment_proxy<ArithmetizationType> &
+                    find_prover(std::vector<assignment_proxy<ArithmetizationType>> &assignments, std::uint32_t id) {
+                    auto it = std::find_if(assignments.begin(), assignments.end(),
+                                           [id](const assignment_proxy<ArithmetizationType> &a) { return a.get_id() == id; });
+                    ASSERT_MSG(it != assignments.end(), "deferred component of an unknown prover");
+                    return *it;
+                }
+
+                // The proxy records a row as used when a witness cell of the row is accessed
+                template<typename Rows>
+                static void mark_used_rows(assignment_proxy<ArithmetizationType> &assignment, const Rows &rows) {
+                    for (std::uint32_t row : rows) {
+                        assignment.witness(0, row);
+                    }
+                }
+
+                std::vector<assignment_task> tasks;
+                std::vector<std::unique_ptr<assignment_proxy<ArithmetizationType>>> task_assignments;
+                std::shared_ptr<assignment<ArithmetizationType>> assignment_table;
+                assignment_thread_pool *pool = nullptr;
+                bool deferring = false;
+                bool enabled = false;
+            };
+        }    // namespace detail
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_DEFERRED_ASSIGNMENTS_HPP
@@ -44,6 +44,8 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 #include <nil/blueprint/policy/policy_manager.hpp>
 
 namespace nil {
@@ -55,11 +57,12 @@ namespace nil {
                 crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>,
                 BlueprintFieldType, basic_non_native_policy<BlueprintFieldType>>::result_type
                 handle_native_field_division_component(
-                    llvm::Value *operand0, llvm::Value *operand1,
-                    typename std::map<const llvm::Value *, crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
+                    std::uint32_t operand0, std::uint32_t operand1,
+                    value_storage<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
                     circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
                     assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                         &assignment,
+                    detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
                     std::uint32_t start_row) {
 
                 using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
@@ -67,26 +70,27 @@ namespace nil {
                 using component_type = components::division<
                     crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>,
                     BlueprintFieldType, basic_non_native_policy<BlueprintFieldType>>;
-                const auto p = PolicyManager::get_parameters(ManifestReader<component_type, ArithmetizationParams>::get_witness(0));
-                component_type component_instance(p.witness, ManifestReader<component_type, ArithmetizationParams>::get_constants(), ManifestReader<component_type, ArithmetizationParams>::get_public_inputs());
+                const component_type &component_instance = ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0));
 
-                var x = variables[operand0];
-                var y = variables[operand1];
+                var x = variables.at_slot(operand0);
+                var y = variables.at_slot(operand1);
 
-                components::generate_circuit(component_instance, bp, assignment, {x, y}, start_row);
-                return components::generate_assignments(component_instance, assignment, {x, y}, start_row);
+                detail::generate_circuit(component_instance, bp, assignment, context, {x, y}, start_row);
+                return detail::generate_assignments(component_instance, assignment, context, {x, y}, start_row);
             }
 
         }    // namespace detail
 
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_field_division_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
             using non_native_policy_type = basic_non_native_policy<BlueprintFieldType>;
 
@@ -106,12 +110,12 @@ namespace nil {
                     if (std::is_same<BlueprintFieldType, operating_field_type>::value) {
                         const auto res =
                             detail::handle_native_field_division_component<BlueprintFieldType, ArithmetizationParams>(
-                                operand0, operand1, frame.scalars, bp, assignment, start_row)
+                                op.operands[0], op.operands[1], frame.scalars, bp, assignment, context, start_row)
                                 .output;
                         if (next_prover) {
-                            frame.scalars[inst] = save_shared_var(assignment, res);
+                            frame.scalars.at_slot(op.result) = save_shared_var(assignment, res);
                         } else {
-                            frame.scalars[inst] = res;
+                            frame.scalars.at_slot(op.result) = res;
                         }
                     } else {
                         UNREACHABLE("Non-native bls12-381 is undefined yet");
@@ -125,12 +129,12 @@ namespace nil {
                     if (std::is_same<BlueprintFieldType, operating_field_type>::value) {
                         const auto res =
                             detail::handle_native_field_division_component<BlueprintFieldType, ArithmetizationParams>(
-                                operand0, operand1, frame.scalars, bp, assignment, start_row)
+                                op.operands[0], op.operands[1], frame.scalars, bp, assignment, context, start_row)
                                 .output;
                         if (next_prover) {
-                            frame.scalars[inst] = save_shared_var(assignment, res);
+                            frame.scalars.at_slot(op.result) = save_shared_var(assignment, res);
                         } else {
-                            frame.scalars[inst] = res;
+                            frame.scalars.at_slot(op.result) = res;
                         }
                     } else {
                         UNREACHABLE("Non-native pallas is undefined yet");
@@ -144,12 +148,12 @@ namespace nil {
                     if (std::is_same<BlueprintFieldType, operating_field_type>::value) {
                         const auto res =
                             detail::handle_native_field_division_component<BlueprintFieldType, ArithmetizationParams>(
-                                operand0, operand1, frame.scalars, bp, assignment, start_row)
+                                op.operands[0], op.operands[1], frame.scalars, bp, assignment, context, start_row)
                                 .output;
                         if (next_prover) {
-                            frame.scalars[inst] = save_shared_var(assignment, res);
+                            frame.scalars.at_slot(op.result) = save_shared_var(assignment, res);
                         } else {
-                            frame.scalars[inst] = res;
+                            frame.scalars.at_slot(op.result) = res;
                         }
                     } else {
                         UNREACHABLE("Non-native ed25519 division is not implemented yet");
@@ -0,0 +1,182 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_GENERATION_MODE_HPP
+#define CRYPTO3_ASSIGNER_GENERATION_MODE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+#include <nil/blueprint/blueprint/plonk/assignment_proxy.hpp>
+#include <nil/blueprint/blueprint/plonk/circuit_proxy.hpp>
+
+#include <nil/blueprint/deferred_assignments.hpp>
+#include <nil/blueprint/policy/policy_manager.hpp>
+
+namespace nil {
+    namespace blueprint {
+
+        enum class generation_mode : std::uint8_t {
+            // Build gates, copy constraints and selectors along with the assignment table
+            CIRCUIT_AND_ASSIGNMENTS,
+            // The circuit is taken from a previous run, only witnesses and public inputs are filled
+            ASSIGNMENTS
+        };
+
+        // Circuit built by a full run together with the table it was built with.
+        // Selector and constant columns of the table don't depend on the input, so they are reused
+        // by the witness-only runs, while the fingerprint and the rows are used to check that
+        // the program went the same way
+        template<typename ArithmetizationType>
+        struct circuit_template {
+            std::shared_ptr<circuit<ArithmetizationType>> bp;
+            std::shared_ptr<assignment<ArithmetizationType>> table;
+            std::size_t fingerprint;
+            std::uint32_t rows_amount;
+        };
+
+        struct prover_cost {
+            std::size_t rows;
+            std::size_t gates;
+            std::size_t copy_constraints;
+        };
+
+        // Size of the tables an input produces, witnesses of the components are not generated for it
+        struct cost_report {
+            std::uint32_t rows_amount;
+            std::uint32_t padded_rows_amount;
+            std::size_t public_inputs_amount;
+            std::vector<prover_cost> provers;
+        };
+
+        namespace detail {
+
+            // State of the component generation owned by a parser, the handlers get it along with
+            // the circuit and the assignment table
+            template<typename ArithmetizationType>
+            struct generation_context {
+                using var = crypto3::zk::snark::plonk_variable<typename ArithmetizationType::field_type::value_type>;
+
+                void set_mode(generation_mode new_mode) {
+                    mode = new_mode;
+                    fingerprint = 0;
+                }
+
+                generation_mode get_mode() const {
+                    return mode;
+                }
+
+                // Placement of the components in the table, the same circuit is produced only if it matches
+                std::size_t get_fingerprint() const {
+                    return fingerprint;
+                }
+
+                void record_component(std::size_t type_hash, std::uint32_t start_row, std::uint32_t rows_amount) {
+                    combine(type_hash);
+                    combine(start_row);
+                    combine(rows_amount);
+                }
+
+                // Values the interpreter needs only for itself (addresses, offsets, results of the native operations)
+                // are kept in the private storage after the private inputs. They get a public input cell only
+                // when a component takes them, so that its copy constraints refer to the table
+                void start_host_values(std::size_t storage_base, std::function<var(const var &)> materializer) {
+                    host_base = storage_base;
+                    materialize = std::move(materializer);
+                }
+
+                bool is_host(const var &v) const {
+                    return v.type == var::column_type::public_input &&
+                           v.index == assignment_proxy<ArithmetizationType>::private_storage_index &&
+                           std::size_t(v.rotation) >= host_base;
+                }
+
+                std::function<var(const var &)> materialize;
+                AssignmentScheduler<ArithmetizationType> *scheduler = nullptr;
+                component_instances components;
+
+            private:
+                void combine(std::size_t value) {
+                    fingerprint ^= value + 0x9e3779b97f4a7c15ull + (fingerprint << 6) + (fingerprint >> 2);
+                }
+
+                generation_mode mode = generation_mode::CIRCUIT_AND_ASSIGNMENTS;
+                std::size_t fingerprint = 0;
+                std::size_t host_base = 0;
+            };
+
+            template<typename ComponentType, typename ArithmetizationType>
+            void generate_circuit(const ComponentType &component_instance,
+                                  circuit_proxy<ArithmetizationType> &bp,
+                                  assignment_proxy<ArithmetizationType> &assignment,
+                                  generation_context<ArithmetizationType> &context,
+                                  const typename ComponentType::input_type &instance_input,
+                                  const std::uint32_t start_row) {
+                context.record_component(typeid(ComponentType).hash_code(), start_row, component_instance.rows_amount);
+                typename ComponentType::input_type input = instance_input;
+                for (auto &v : input.all_vars()) {
+                    if (context.is_host(v)) {
+                        v.get() = context.materialize(v);
+                    }
+                }
+                if (context.get_mode() == generation_mode::CIRCUIT_AND_ASSIGNMENTS) {
+                    components::generate_circuit(component_instance, bp, assignment, input, start_row);
+                }
+            }
+
+            template<typename ComponentType, typename ArithmetizationType>
+            typename ComponentType::result_type generate_assignments(const ComponentType &component_instance,
+                                                                     assignment_proxy<ArithmetizationType> &assignment,
+                                                                     generation_context<ArithmetizationType> &context,
+                                                                     const typename ComponentType::input_type &instance_input,
+                                                                     const std::uint32_t start_row) {
+                if (context.scheduler != nullptr && context.scheduler->is_deferring()) {
+                    return context.scheduler->defer(component_instance, assignment, instance_input, start_row);
+                }
+                return components::generate_assignments(component_instance, assignment, instance_input, start_row);
+            }
+
+            // Selectors are enabled and constants are placed by generate_circuit, take them from the template
+            template<typename ArithmetizationType>
+            void copy_circuit_columns(const assignment<ArithmetizationType> &from, assignment<ArithmetizationType> &to) {
+                for (std::uint32_t i = 0; i < from.selectors_amount(); i++) {
+                    for (std::uint32_t j = 0; j < from.selector_column_size(i); j++) {
+                        to.selector(i, j) = from.selector(i, j);
+                    }
+                }
+                for (std::uint32_t i = 0; i < from.constants_amount(); i++) {
+                    for (std::uint32_t j = 0; j < from.constant_column_size(i); j++) {
+                        to.constant(i, j) = from.constant(i, j);
+                    }
+                }
+            }
+        }    // namespace detail
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_GENERATION_MODE_HPP
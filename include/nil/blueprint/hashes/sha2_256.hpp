@@ -42,18 +42,22 @@
 #include <nil/blueprint/components/hashes/sha2/plonk/sha256.hpp>
 
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 #include <nil/blueprint/policy/policy_manager.hpp>
 
 namespace nil {
     namespace blueprint {
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_sha2_256_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignmnt,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
             using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
             using component_type = components::sha256<
@@ -62,28 +66,25 @@ namespace nil {
             constexpr const std::int32_t block_size = 2;
             constexpr const std::int32_t input_blocks_amount = 2;
 
-            auto &block_arg = frame.vectors[inst->getOperand(0)];
+            auto &block_arg = frame.vectors.at_slot(op.operands[0]);
             std::array<var, input_blocks_amount * block_size> input_block_vars;
             std::copy(block_arg.begin(), block_arg.end(), input_block_vars.begin());
 
             typename component_type::input_type instance_input = {input_block_vars};
 
-            const auto p = detail::PolicyManager::get_parameters(detail::ManifestReader<component_type, ArithmetizationParams>::get_witness(0));
+            const component_type &component_instance = detail::ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0));
 
-            component_type component_instance(p.witness, detail::ManifestReader<component_type, ArithmetizationParams>::get_constants(),
-                                              detail::ManifestReader<component_type, ArithmetizationParams>::get_public_inputs());
-
-            components::generate_circuit(component_instance, bp, assignmnt, instance_input, start_row);
+            detail::generate_circuit(component_instance, bp, assignmnt, context, instance_input, start_row);
 
             typename component_type::result_type component_result =
-                components::generate_assignments(component_instance, assignmnt, instance_input, start_row);
+                detail::generate_assignments(component_instance, assignmnt, context, instance_input, start_row);
 
             std::vector<var> output(component_result.output.begin(), component_result.output.end());
 
             if (next_prover) {
-                frame.vectors[inst] = save_shared_var(assignmnt, output);
+                frame.vectors.at_slot(op.result) = save_shared_var(assignmnt, output);
             } else {
-                frame.vectors[inst] = output;
+                frame.vectors.at_slot(op.result) = output;
             }
         }
     }    // namespace blueprint
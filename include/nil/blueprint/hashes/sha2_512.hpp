@@ -43,18 +43,22 @@
 #include <nil/blueprint/components/algebra/fields/plonk/non_native/reduction.hpp>
 
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 #include <nil/blueprint/policy/policy_manager.hpp>
 
 namespace nil {
     namespace blueprint {
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_sha2_512_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignmnt,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
             using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
             using sha2_512_component_type = components::sha512<
@@ -63,12 +67,12 @@ namespace nil {
             constexpr const std::int32_t ec_point_size = 2*4;
             constexpr const std::int32_t input_size = 2*ec_point_size + 4;
 
-            const auto &arg0 = frame.vectors[inst->getOperand(0)];
+            const auto &arg0 = frame.vectors.at_slot(op.operands[0]);
             std::array<var, input_size> input_vars;
             std::copy(arg0.begin(), arg0.end(), input_vars.begin());
-            const auto &arg1 = frame.vectors[inst->getOperand(1)];
+            const auto &arg1 = frame.vectors.at_slot(op.operands[1]);
             std::copy(arg1.begin(), arg1.end(), input_vars.begin() + arg0.size());
-            const auto &arg2 = frame.vectors[inst->getOperand(2)];
+            const auto &arg2 = frame.vectors.at_slot(op.operands[2]);
             std::copy(arg2.begin(), arg2.end(), input_vars.begin() + arg0.size() + arg1.size());
 
             typename sha2_512_component_type::var_ec_point R = {{{input_vars[0], input_vars[1], input_vars[2], input_vars[3]}},
@@ -78,39 +82,32 @@ namespace nil {
 
             typename sha2_512_component_type::input_type sha2_512_instance_input = {R, A, {{input_vars[16], input_vars[17],
                 input_vars[18], input_vars[19]}}};
-            const auto p_sha2_512 = detail::PolicyManager::get_parameters(detail::ManifestReader<sha2_512_component_type, ArithmetizationParams>::get_witness(0));
-            sha2_512_component_type sha2_512_component_instance(p_sha2_512.witness,
-                                                                detail::ManifestReader<sha2_512_component_type, ArithmetizationParams>::get_constants(),
-                                                                detail::ManifestReader<sha2_512_component_type, ArithmetizationParams>::get_public_inputs());
+            const sha2_512_component_type &sha2_512_component_instance = detail::ComponentCache<sha2_512_component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0));
 
-            components::generate_circuit(sha2_512_component_instance, bp, assignmnt, sha2_512_instance_input, start_row);
+            detail::generate_circuit(sha2_512_component_instance, bp, assignmnt, context, sha2_512_instance_input, start_row);
 
             typename sha2_512_component_type::result_type sha2_512_component_result =
-                components::generate_assignments(sha2_512_component_instance, assignmnt, sha2_512_instance_input, start_row);
+                detail::generate_assignments(sha2_512_component_instance, assignmnt, context, sha2_512_instance_input, start_row);
 
             using reduction_component_type = components::reduction<
                 crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>, BlueprintFieldType,
                 basic_non_native_policy<BlueprintFieldType>>;
 
-            const auto p = detail::PolicyManager::get_parameters(detail::ManifestReader<reduction_component_type, ArithmetizationParams>::get_witness(0));
-
-            reduction_component_type reduction_component_instance(p.witness,
-                                                                  detail::ManifestReader<reduction_component_type, ArithmetizationParams>::get_constants(),
-                                                                  detail::ManifestReader<reduction_component_type, ArithmetizationParams>::get_public_inputs());
+            const reduction_component_type &reduction_component_instance = detail::ComponentCache<reduction_component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0));
 
             start_row = assignmnt.allocated_rows();
 
             typename reduction_component_type::input_type reduction_instance_input = {sha2_512_component_result.output_state};
 
-            components::generate_circuit(reduction_component_instance, bp, assignmnt, reduction_instance_input, start_row);
+            detail::generate_circuit(reduction_component_instance, bp, assignmnt, context, reduction_instance_input, start_row);
 
             typename reduction_component_type::result_type reduction_component_result =
-                components::generate_assignments(reduction_component_instance, assignmnt, reduction_instance_input, start_row);
+                detail::generate_assignments(reduction_component_instance, assignmnt, context, reduction_instance_input, start_row);
 
             if (next_prover) {
-                frame.scalars[inst] = save_shared_var(assignmnt, reduction_component_result.output);
+                frame.scalars.at_slot(op.result) = save_shared_var(assignmnt, reduction_component_result.output);
             } else {
-                frame.scalars[inst] = reduction_component_result.output;
+                frame.scalars.at_slot(op.result) = reduction_component_result.output;
             }
         }
     }    // namespace blueprint
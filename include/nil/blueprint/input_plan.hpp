@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_INPUT_PLAN_HPP
+#define CRYPTO3_ASSIGNER_INPUT_PLAN_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Type.h"
+
+#include <nil/blueprint/asserts.hpp>
+#include <nil/blueprint/layout_resolver.hpp>
+#include <nil/blueprint/non_native_marshalling.hpp>
+
+namespace nil {
+    namespace blueprint {
+        enum class input_kind { struct_ret, aggregate, string, vector, curve, field, integer };
+
+        struct input_argument {
+            input_kind kind;
+            // The pointee for StructRet and ByVal pointers, the argument type otherwise
+            llvm::Type *type;
+            // Rows taken in the input column, strings take one more row per character
+            std::size_t cells;
+            bool is_private;
+        };
+
+        // How the arguments of a circuit are read, compiled once from the function signature
+        // and shared by all the inputs the circuit is evaluated on
+        struct input_plan {
+            const llvm::Function *function = nullptr;
+            std::vector<input_argument> arguments;
+            // Values expected in the input file, StructRet arguments take none
+            std::size_t values_amount = 0;
+            std::size_t public_cells = 0;
+            std::size_t private_cells = 0;
+            // The cell amounts do not depend on the input, i.e. there are no strings
+            bool exact = true;
+        };
+
+        namespace detail {
+            template<typename BlueprintFieldType>
+            std::size_t leaf_input_cells(llvm::Type *type) {
+                switch (type->getTypeID()) {
+                case llvm::Type::GaloisFieldTyID:
+                    return field_arg_num<BlueprintFieldType>(type);
+                case llvm::Type::EllipticCurveTyID:
+                    return curve_arg_num<BlueprintFieldType>(type);
+                case llvm::Type::IntegerTyID:
+                    return 1;
+                case llvm::Type::FixedVectorTyID: {
+                    auto *vector_type = llvm::cast<llvm::FixedVectorType>(type);
+                    return vector_type->getNumElements() *
+                           leaf_input_cells<BlueprintFieldType>(vector_type->getElementType());
+                }
+                default:
+                    UNREACHABLE("unsupported input type");
+                }
+            }
+        }    // namespace detail
+
+        template<typename BlueprintFieldType>
+        input_plan compile_input_plan(const llvm::Function &function, LayoutResolver &layout_resolver) {
+            input_plan plan;
+            plan.function = &function;
+            plan.arguments.reserve(function.arg_size());
+            for (const llvm::Argument &arg : function.args()) {
+                input_argument argument;
+                argument.is_private = arg.hasAttribute(llvm::Attribute::PrivateInput);
+                llvm::Type *arg_type = arg.getType();
+                if (llvm::isa<llvm::PointerType>(arg_type) && arg.hasStructRetAttr()) {
+                    argument.kind = input_kind::struct_ret;
+                    argument.type = arg.getAttribute(llvm::Attribute::StructRet).getValueAsType();
+                    argument.cells = 1;
+                } else if (llvm::isa<llvm::PointerType>(arg_type) && arg.hasAttribute(llvm::Attribute::ByVal)) {
+                    argument.kind = input_kind::aggregate;
+                    argument.type = arg.getAttribute(llvm::Attribute::ByVal).getValueAsType();
+                    if (!argument.type->isStructTy() && !argument.type->isArrayTy()) {
+                        UNREACHABLE("unsupported pointer type");
+                    }
+                    // The pointer and the cells it points to
+                    argument.cells = 1 + layout_resolver.get_type_layout<BlueprintFieldType>(argument.type).size();
+                } else if (llvm::isa<llvm::PointerType>(arg_type)) {
+                    argument.kind = input_kind::string;
+                    argument.type = arg_type;
+                    // The pointer and the terminating zero
+                    argument.cells = 2;
+                    plan.exact = false;
+                } else {
+                    switch (arg_type->getTypeID()) {
+                    case llvm::Type::FixedVectorTyID:
+                        argument.kind = input_kind::vector;
+                        break;
+                    case llvm::Type::EllipticCurveTyID:
+                        argument.kind = input_kind::curve;
+                        break;
+                    case llvm::Type::GaloisFieldTyID:
+                        argument.kind = input_kind::field;
+                        break;
+                    case llvm::Type::IntegerTyID:
+                        argument.kind = input_kind::integer;
+                        break;
+                    default:
+                        UNREACHABLE("unsupported input type");
+                    }
+                    argument.type = arg_type;
+                    argument.cells = detail::leaf_input_cells<BlueprintFieldType>(arg_type);
+                }
+
+                if (argument.kind != input_kind::struct_ret) {
+                    ++plan.values_amount;
+                }
+                (argument.is_private ? plan.private_cells : plan.public_cells) += argument.cells;
+                plan.arguments.push_back(argument);
+            }
+            return plan;
+        }
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_INPUT_PLAN_HPP
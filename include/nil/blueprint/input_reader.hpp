@@ -30,16 +30,95 @@
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Type.h"
 
+#include <nil/blueprint/binary_input.hpp>
+#include <nil/blueprint/deferred_assignments.hpp>
+#include <nil/blueprint/input_plan.hpp>
+#include <nil/blueprint/json_token_stream.hpp>
 #include <nil/blueprint/layout_resolver.hpp>
 
 #include <nil/blueprint/stack.hpp>
 #include <nil/blueprint/non_native_marshalling.hpp>
+#include <nil/blueprint/number_parser.hpp>
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <boost/json/src.hpp>
 
 namespace nil {
     namespace blueprint {
+        // A number of the input file, taken either from a parsed JSON value or from a token of the stream
+        struct input_number {
+            enum class kind_type { int64, uint64, double_, string, other };
+
+            kind_type kind = kind_type::other;
+            std::int64_t int64 = 0;
+            std::uint64_t uint64 = 0;
+            std::string_view text;
+
+            static input_number from(const boost::json::value &value) {
+                input_number res;
+                switch (value.kind()) {
+                case boost::json::kind::int64:
+                    res.kind = kind_type::int64;
+                    res.int64 = value.get_int64();
+                    break;
+                case boost::json::kind::uint64:
+                    res.kind = kind_type::uint64;
+                    res.uint64 = value.get_uint64();
+                    break;
+                case boost::json::kind::double_:
+                    res.kind = kind_type::double_;
+                    break;
+                case boost::json::kind::string:
+                    res.kind = kind_type::string;
+                    res.text = std::string_view(value.get_string().data(), value.get_string().size());
+                    break;
+                default:
+                    break;
+                }
+                return res;
+            }
+
+            // The text of a string token is referenced, so the token must outlive the number
+            static input_number from(const json_token &token) {
+                input_number res;
+                switch (token.kind) {
+                case json_token::kind_type::int64:
+                    res.kind = kind_type::int64;
+                    res.int64 = token.int64;
+                    break;
+                case json_token::kind_type::uint64:
+                    res.kind = kind_type::uint64;
+                    res.uint64 = token.uint64;
+                    break;
+                case json_token::kind_type::double_:
+                    res.kind = kind_type::double_;
+                    break;
+                case json_token::kind_type::string:
+                    res.kind = kind_type::string;
+                    res.text = token.text;
+                    break;
+                default:
+                    break;
+                }
+                return res;
+            }
+
+            std::string to_string() const {
+                switch (kind) {
+                case kind_type::int64:
+                    return std::to_string(int64);
+                case kind_type::uint64:
+                    return std::to_string(uint64);
+                case kind_type::string:
+                    return "\"" + std::string(text) + "\"";
+                default:
+                    return "non-integer value";
+                }
+            }
+        };
+
         template<typename BlueprintFieldType, typename var, typename Assignment>
         class InputReader {
         public:
@@ -62,15 +141,23 @@ namespace nil {
                 size_t arg_len = curve_arg_num<BlueprintFieldType>(curve_type);
                 ASSERT_MSG(arg_len >= 2, "arg_len of curveTy cannot be less than two");
                 if (value.size() != 1 || !value.contains("curve")) {
-                    std::cerr << "error in json value:\n" << value << "\n";
-                    UNREACHABLE("value.size() != 1 || !value.contains(\"curve\")");
+                    error = "expected {\"curve\": ...}, got " + boost::json::serialize(value);
+                    return {};
+                }
+                if (!value.at("curve").is_array() || value.at("curve").as_array().size() != 2) {
+                    error = "curve element consists of two field elements";
+                    return {};
                 }
-                ASSERT_MSG(value.at("curve").is_array(), "curve element must be array!");
-                ASSERT_MSG((value.at("curve").as_array().size() == 2), "curve element consists of two field elements!");
 
                 llvm::GaloisFieldKind arg_field_type = curve_type->GetBaseFieldKind();
                 std::vector<var> vector1 = process_non_native_field (value.at("curve").as_array()[0], arg_field_type, is_private);
+                if (vector1.empty()) {
+                    return {};
+                }
                 std::vector<var> vector2 = process_non_native_field (value.at("curve").as_array()[1], arg_field_type, is_private);
+                if (vector2.empty()) {
+                    return {};
+                }
                 vector1.insert(vector1.end(), vector2.begin(), vector2.end());
                 return vector1;
             }
@@ -80,7 +167,7 @@ namespace nil {
                     return false;
                 }
                 frame.vectors[curve_arg] = process_curve(llvm::cast<llvm::EllipticCurveType>(curve_type), value, is_private);
-                return true;
+                return !frame.vectors[curve_arg].empty();
             }
 
             std::vector<var> put_field_into_assignmnt (std::vector<typename BlueprintFieldType::value_type> input, bool is_private) {
@@ -95,72 +182,110 @@ namespace nil {
             }
 
             std::vector<var> process_non_native_field (const boost::json::value &value, llvm::GaloisFieldKind arg_field_type, bool is_private) {
-                std::vector<var> res;
                 std::vector<typename BlueprintFieldType::value_type> chunked_non_native_field_element;
-                typename BlueprintFieldType::extended_integral_type non_native_number;
+                if (!decode_field(input_number::from(value), arg_field_type, chunked_non_native_field_element, error)) {
+                    return {};
+                }
+                return put_field_into_assignmnt(chunked_non_native_field_element, is_private);
+            }
 
-                const std::size_t buflen = 256;
-                char buf[buflen];
-                std::size_t numlen = 0;
+            // The decoders do not touch the assignment or the reader state, so they can run on any thread
+            static bool decode_field(const input_number &value, llvm::GaloisFieldKind arg_field_type,
+                                     std::vector<typename BlueprintFieldType::value_type> &out, std::string &error) {
+                typename BlueprintFieldType::extended_integral_type non_native_number;
 
-                switch (value.kind()) {
-                case boost::json::kind::int64:
-                    non_native_number = typename BlueprintFieldType::extended_integral_type(value.as_int64());
-                    chunked_non_native_field_element = extended_integral_into_vector<BlueprintFieldType> (arg_field_type, non_native_number);
-                    res = put_field_into_assignmnt(chunked_non_native_field_element, is_private);
-                    return res;
+                switch (value.kind) {
+                case input_number::kind_type::int64:
+                    non_native_number = typename BlueprintFieldType::extended_integral_type(value.int64);
                     break;
-
-                case boost::json::kind::uint64:
-                    non_native_number = typename BlueprintFieldType::extended_integral_type(value.as_uint64());
-                    chunked_non_native_field_element = extended_integral_into_vector<BlueprintFieldType> (arg_field_type, non_native_number);
-                    res = put_field_into_assignmnt(chunked_non_native_field_element, is_private);
-                    return res;
+                case input_number::kind_type::uint64:
+                    non_native_number = typename BlueprintFieldType::extended_integral_type(value.uint64);
                     break;
-
-                case boost::json::kind::string:
-                    numlen = value.as_string().size();
-                    if (numlen > buflen - 1) {
-                        std::cerr << "value " << value.as_string() << " exceeds buffer size (" << buflen - 1 << ")\n";
-                        UNREACHABLE("value size exceeds buffer size");
+                case input_number::kind_type::double_:
+                    error =
+                        "got double value for field argument. Probably the value is too big to be represented as "
+                        "integer. You can put it in \"\" to avoid JSON parser restrictions.";
+                    return false;
+                case input_number::kind_type::string:
+                    if (!parse_number(value.text, non_native_number, error)) {
+                        return false;
                     }
-                    value.as_string().copy(buf, numlen);
-                    buf[numlen] = '\0';
-                    non_native_number = typename BlueprintFieldType::extended_integral_type(buf);
+                    break;
+                default:
+                    error = "unexpected field value, expected an integer or a string";
+                    return false;
+                }
 
-                    chunked_non_native_field_element = extended_integral_into_vector<BlueprintFieldType> (arg_field_type, non_native_number);
+                if (!fits_field_modulus<BlueprintFieldType>(arg_field_type, non_native_number)) {
+                    error = "value " + value.to_string() + " does not fit into the field modulus";
+                    return false;
+                }
+                out = extended_integral_into_vector<BlueprintFieldType>(arg_field_type, non_native_number);
+                return true;
+            }
 
-                    res = put_field_into_assignmnt(chunked_non_native_field_element, is_private);
-                    return res;
-                    break;
+            static bool decode_int(const input_number &value, std::size_t bitness,
+                                   typename BlueprintFieldType::value_type &out, std::string &error) {
+                switch (value.kind) {
+                case input_number::kind_type::int64:
+                    if (bitness < 64 && value.int64 >> bitness > 0) {
+                        error = "value " + std::to_string(value.int64) + " does not fit into " +
+                                std::to_string(bitness) + " bits";
+                        return false;
+                    }
+                    out = value.int64;
+                    return true;
+                case input_number::kind_type::uint64:
+                    if (bitness < 64 && value.uint64 >> bitness > 0) {
+                        error = "value " + std::to_string(value.uint64) + " does not fit into " +
+                                std::to_string(bitness) + " bits";
+                        return false;
+                    }
+                    out = value.uint64;
+                    return true;
+                case input_number::kind_type::double_:
+                    error =
+                        "got double value for int argument. Probably the value is too big to be represented as "
+                        "integer. You can put it in \"\" to avoid JSON parser restrictions.";
+                    return false;
+                case input_number::kind_type::string: {
+                    typename BlueprintFieldType::extended_integral_type number;
+                    if (!parse_number(value.text, number, error)) {
+                        return false;
+                    }
+                    typename BlueprintFieldType::extended_integral_type one = 1;
+                    ASSERT_MSG(bitness <= 128, "integers larger than 128 bits are not supported, try to use field types");
+                    typename BlueprintFieldType::extended_integral_type max_size = one << bitness;
+                    if (number >= max_size) {
+                        error = "value " + std::string(value.text) + " does not fit into " + std::to_string(bitness) +
+                                " bits, try to use other type";
+                        return false;
+                    }
+                    out = number;
+                    return true;
+                }
                 default:
-                    return {};
+                    error = "process_int handles only ints";
+                    return false;
                 }
             }
 
             std::vector<var> process_field (llvm::GaloisFieldType *field_type, const boost::json::object &value, bool is_private) {
                 ASSERT(llvm::isa<llvm::GaloisFieldType>(field_type));
                 if (value.size() != 1 || !value.contains("field")){
-                    std::cerr << "error in json value:\n" << value << "\n";
-                    UNREACHABLE("value.size() != 1 || !value.contains(\"field\")");
+                    error = "expected {\"field\": ...}, got " + boost::json::serialize(value);
+                    return {};
                 }
                 size_t arg_len = field_arg_num<BlueprintFieldType>(field_type);
                 ASSERT_MSG(arg_len != 0, "wrong input size");
                 llvm::GaloisFieldKind arg_field_type = field_type->getFieldKind();
 
-                if (value.at("field").is_double()) {
-                    std::cerr << "error in json value:\n" << value << "\n";
-                    error =
-                        "got double value for field argument. Probably the value is too big to be represented as "
-                        "integer. You can put it in \"\" to avoid JSON parser restrictions.";
-                    UNREACHABLE("got double type value");
-                }
                 auto values = process_non_native_field(value.at("field"), arg_field_type, is_private);
                 if (values.size() != arg_len) {
-                    std::cerr << "error in json value:\n" << value << "\n";
-                    std::cerr << "values.size() != arg_len\n";
-                    std::cerr << "values.size() = "  << values.size() << ", arg_len = " << arg_len<< std::endl;
-                    UNREACHABLE("value size != arg_len");
+                    if (error.empty()) {
+                        error = "wrong field value " + boost::json::serialize(value);
+                    }
+                    return {};
                 }
                 return values;
             }
@@ -171,6 +296,9 @@ namespace nil {
                     return false;
                 }
                 std::vector<var> values = process_field(llvm::cast<llvm::GaloisFieldType>(field_type), value, is_private);
+                if (values.empty()) {
+                    return false;
+                }
                 if (values.size() == 1) {
                     frame.scalars[field_arg] = values[0];
                 } else {
@@ -180,64 +308,15 @@ namespace nil {
             }
 
             std::vector<var> process_int(const boost::json::object &object, std::size_t bitness, bool is_private) {
-                ASSERT(object.size() == 1 && object.contains("int"));
-                std::vector<var> res = std::vector<var>(1);
-
-                typename BlueprintFieldType::value_type out;
-
-                switch (object.at("int").kind()) {
-                case boost::json::kind::int64:
-                    if (bitness < 64 && object.at("int").as_int64() >> bitness > 0) {
-                        std::cerr << "value " << object.at("int").as_int64() << " does not fit into " << bitness << " bits\n";
-                        UNREACHABLE("one of the input values is too large");
-                    }
-                    out = object.at("int").as_int64();
-                    break;
-                case boost::json::kind::uint64:
-                    if (bitness < 64 && object.at("int").as_uint64() >> bitness > 0) {
-                        std::cerr << "value " << object.at("int").as_uint64() << " does not fit into " << bitness << " bits\n";
-                        UNREACHABLE("one of the input values is too large");
-                    }
-                    out = object.at("int").as_uint64();
-                    break;
-                case boost::json::kind::double_: {
-                    std::cerr << "error in json value " <<  boost::json::serialize(object) << "\n";
-                    error =
-                        "got double value for int argument. Probably the value is too big to be represented as "
-                        "integer. You can put it in \"\" to avoid JSON parser restrictions.";
-                    UNREACHABLE(error);
-                }
-                case boost::json::kind::string: {
-                    const std::size_t buflen = 256;
-                    char buf[buflen];
-
-                    std::size_t numlen = object.at("int").as_string().size();
-
-                    if (numlen > buflen - 1) {
-                        std::cerr << "value " << object.at("int").as_string() << " exceeds buffer size (" << buflen - 1 << ")\n";
-                        UNREACHABLE("value size exceeds buffer size");
-                    }
-
-                    object.at("int").as_string().copy(buf, numlen);
-                    buf[numlen] = '\0';
-                    typename BlueprintFieldType::extended_integral_type number = typename BlueprintFieldType::extended_integral_type(buf);
-                    typename BlueprintFieldType::extended_integral_type one = 1;
-                    ASSERT_MSG(bitness <= 128, "integers larger than 128 bits are not supported, try to use field types");
-                    typename BlueprintFieldType::extended_integral_type max_size = one << bitness;
-                    if (number >= max_size) {
-                        std::cout << "value " << buf << " does not fit into " << bitness << " bits, try to use other type\n";
-                        UNREACHABLE("input value is too big");
-                    }
-                    out = number;
-                    break;
+                if (object.size() != 1 || !object.contains("int")) {
+                    error = "expected {\"int\": ...}, got " + boost::json::serialize(object);
+                    return {};
                 }
-                default:
-                    UNREACHABLE("process_int handles only ints");
-                    break;
+                typename BlueprintFieldType::value_type out;
+                if (!decode_int(input_number::from(object.at("int")), bitness, out, error)) {
+                    return {};
                 }
-
-                res[0] = put_into_assignment(out, is_private);
-                return res;
+                return {put_into_assignment(out, is_private)};
             }
 
             bool take_int(llvm::Value *int_arg, const boost::json::object &value, bool is_private) {
@@ -253,7 +332,8 @@ namespace nil {
 
             bool take_vector(llvm::Value *vector_arg, llvm::Type *vector_type, const boost::json::object &value, bool is_private) {
                 size_t arg_len = llvm::cast<llvm::FixedVectorType>(vector_type)->getNumElements();
-                if (value.size() != 1 && !value.contains("vector")) {
+                if (value.size() != 1 || !value.contains("vector")) {
+                    error = "expected {\"vector\": ...}, got " + boost::json::serialize(value);
                     return false;
                 }
                 frame.vectors[vector_arg] = process_vector(llvm::cast<llvm::FixedVectorType>(vector_type), value, is_private);
@@ -264,10 +344,8 @@ namespace nil {
                 if (!arg_type->isPointerTy()) {
                     return false;
                 }
-                if (value.size() != 1 && !value.contains("string")) {
-                    return false;
-                }
-                if (!value.at("string").is_string()) {
+                if (value.size() != 1 || !value.contains("string") || !value.at("string").is_string()) {
+                    error = "expected {\"string\": \"...\"}, got " + boost::json::serialize(value);
                     return false;
                 }
                 const auto &json_str = value.at("string").as_string();
@@ -289,7 +367,9 @@ namespace nil {
 
             bool try_struct(llvm::Value *arg, llvm::StructType *struct_type, const boost::json::object &value, bool is_private) {
                 ptr_type ptr = memory.add_cells(layout_resolver.get_type_layout<BlueprintFieldType>(struct_type));
-                process_struct(struct_type, value, ptr, is_private);
+                if (process_struct(struct_type, value, ptr, is_private) == 0) {
+                    return false;
+                }
                 auto variable = put_into_assignment(ptr, is_private);
                 frame.scalars[arg] = variable;
                 return true;
@@ -297,34 +377,141 @@ namespace nil {
 
             bool try_array(llvm::Value *arg, llvm::ArrayType *array_type, const boost::json::object &value, bool is_private) {
                 ptr_type ptr = memory.add_cells(layout_resolver.get_type_layout<BlueprintFieldType>(array_type));
-                process_array(array_type, value, ptr, is_private);
+                if (process_array(array_type, value, ptr, is_private) == 0) {
+                    return false;
+                }
                 auto variable = put_into_assignment(ptr, is_private);;
                 frame.scalars[arg] = variable;
                 return true;
             }
 
             ptr_type process_array(llvm::ArrayType *array_type, const boost::json::object &value, ptr_type ptr, bool is_private) {
-                ASSERT(value.size() == 1 && value.contains("array"));
-                ASSERT(value.at("array").is_array());
+                if (value.size() != 1 || !value.contains("array") || !value.at("array").is_array()) {
+                    error = "expected {\"array\": [...]}, got " + boost::json::serialize(value);
+                    return 0;
+                }
                 auto &arr = value.at("array").as_array();
-                ASSERT(array_type->getNumElements() == arr.size());
-                for (size_t i = 0; i < array_type->getNumElements(); ++i) {
+                if (array_type->getNumElements() != arr.size()) {
+                    error = "expected " + std::to_string(array_type->getNumElements()) + " array elements, got " +
+                            std::to_string(arr.size());
+                    return 0;
+                }
+                if (is_bulk_element(array_type->getElementType())) {
+                    return process_bulk_array(array_type->getElementType(), arr, ptr, is_private);
+                }
+                for (size_t i = 0; i < array_type->getNumElements() && ptr != 0; ++i) {
                     ptr = dispatch_type(array_type->getElementType(), arr[i], ptr, is_private);
                 }
                 return ptr;
             }
 
+            // Arrays of ints or fields are decoded in one loop without dispatching on every element,
+            // long ones are split between the workers of the pool. The values go to consecutive input rows
+            static bool is_bulk_element(llvm::Type *type) {
+                return type->isIntegerTy() || type->isFieldTy();
+            }
+
+            ptr_type process_bulk_array(llvm::Type *elem_type, const boost::json::array &arr, ptr_type ptr, bool is_private) {
+                const bool is_field = elem_type->isFieldTy();
+                const char *key = is_field ? "field" : "int";
+                std::size_t bitness = is_field ? 0 : elem_type->getPrimitiveSizeInBits();
+                llvm::GaloisFieldKind field_kind = is_field ? llvm::cast<llvm::GaloisFieldType>(elem_type)->getFieldKind()
+                                                            : llvm::GaloisFieldKind();
+                std::size_t elem_len = is_field ? field_arg_num<BlueprintFieldType>(elem_type) : 1;
+
+                std::vector<typename BlueprintFieldType::value_type> values(arr.size() * elem_len);
+                auto decode_range = [&](std::size_t begin, std::size_t end, std::string &range_error) {
+                    std::vector<typename BlueprintFieldType::value_type> chunks;
+                    for (std::size_t i = begin; i < end; ++i) {
+                        const boost::json::object *object = arr[i].if_object();
+                        const boost::json::value *payload =
+                            object != nullptr && object->size() == 1 ? object->if_contains(key) : nullptr;
+                        if (payload == nullptr) {
+                            range_error = std::string("expected {\"") + key + "\": ...}, got " + boost::json::serialize(arr[i]);
+                            return;
+                        }
+                        if (!is_field) {
+                            if (!decode_int(input_number::from(*payload), bitness, values[i], range_error)) {
+                                return;
+                            }
+                            continue;
+                        }
+                        if (!decode_field(input_number::from(*payload), field_kind, chunks, range_error)) {
+                            return;
+                        }
+                        if (chunks.size() != elem_len) {
+                            range_error = "wrong field value " + boost::json::serialize(arr[i]);
+                            return;
+                        }
+                        std::copy(chunks.begin(), chunks.end(), values.begin() + i * elem_len);
+                    }
+                };
+
+                std::string decode_error;
+                std::size_t chunks_amount = (arr.size() + bulk_chunk_size - 1) / bulk_chunk_size;
+                if (thread_pool == nullptr || chunks_amount < 2) {
+                    decode_range(0, arr.size(), decode_error);
+                } else {
+                    std::vector<std::string> errors(chunks_amount);
+                    std::vector<detail::assignment_task> chunks(chunks_amount);
+                    for (std::size_t t = 0; t < chunks_amount; ++t) {
+                        std::size_t begin = t * bulk_chunk_size;
+                        std::size_t end = std::min(arr.size(), begin + bulk_chunk_size);
+                        chunks[t].run = [&decode_range, &errors, begin, end, t]() { decode_range(begin, end, errors[t]); };
+                        chunks[t].unresolved = 0;
+                    }
+                    thread_pool->run(chunks);
+                    for (const std::string &range_error : errors) {
+                        if (!range_error.empty()) {
+                            decode_error = range_error;
+                            break;
+                        }
+                    }
+                }
+                if (!decode_error.empty()) {
+                    error = decode_error;
+                    return 0;
+                }
+                return store_bulk(values, ptr, is_private);
+            }
+
+            ptr_type store_bulk(const std::vector<typename BlueprintFieldType::value_type> &values, ptr_type ptr,
+                                bool is_private) {
+                std::vector<var> cells;
+                cells.reserve(values.size());
+                if (is_private) {
+                    for (const auto &value : values) {
+                        assignmnt.private_storage(private_input_idx) = value;
+                        cells.emplace_back(Assignment::private_storage_index, private_input_idx++, false,
+                                           var::column_type::public_input);
+                    }
+                } else {
+                    for (const auto &value : values) {
+                        assignmnt.public_input(0, public_input_idx) = value;
+                        cells.emplace_back(0, public_input_idx++, false, var::column_type::public_input);
+                    }
+                }
+                memory.store(ptr, cells.begin(), cells.end());
+                return ptr + cells.size();
+            }
+
             ptr_type process_struct(llvm::StructType *struct_type, const boost::json::object &value, ptr_type ptr, bool is_private) {
-                ASSERT(value.size() == 1);
-                if (value.contains("array") && struct_type->getNumElements() == 1 &&
+                if (value.size() == 1 && value.contains("array") && struct_type->getNumElements() == 1 &&
                     struct_type->getElementType(0)->isArrayTy()) {
                     // Assuming std::array
                     return process_array(llvm::cast<llvm::ArrayType>(struct_type->getElementType(0)), value, ptr, is_private);
                 }
-                ASSERT(value.contains("struct") && value.at("struct").is_array());
+                if (value.size() != 1 || !value.contains("struct") || !value.at("struct").is_array()) {
+                    error = "expected {\"struct\": [...]}, got " + boost::json::serialize(value);
+                    return 0;
+                }
                 auto &arr = value.at("struct").as_array();
-                ASSERT(arr.size() == struct_type->getNumElements());
-                for (unsigned i = 0; i < struct_type->getNumElements(); ++i) {
+                if (arr.size() != struct_type->getNumElements()) {
+                    error = "expected " + std::to_string(struct_type->getNumElements()) + " struct elements, got " +
+                            std::to_string(arr.size());
+                    return 0;
+                }
+                for (unsigned i = 0; i < struct_type->getNumElements() && ptr != 0; ++i) {
                     auto elem_ty = struct_type->getElementType(i);
                     ptr = dispatch_type(elem_ty, arr[i], ptr, is_private);
                 }
@@ -332,14 +519,26 @@ namespace nil {
             }
 
             std::vector<var> process_vector(llvm::FixedVectorType *vector_type, const boost::json::object &value, bool is_private) {
-                ASSERT(value.size() == 1 && value.contains("vector"));
-                ASSERT(value.at("vector").is_array());
+                if (value.size() != 1 || !value.contains("vector") || !value.at("vector").is_array()) {
+                    error = "expected {\"vector\": [...]}, got " + boost::json::serialize(value);
+                    return {};
+                }
                 auto &vec = value.at("vector").as_array();
-                ASSERT(vector_type->getNumElements() == vec.size());
+                if (vector_type->getNumElements() != vec.size()) {
+                    error = "expected " + std::to_string(vector_type->getNumElements()) + " vector elements, got " +
+                            std::to_string(vec.size());
+                    return {};
+                }
                 std::vector<var> res;
                 for (size_t i = 0; i < vector_type->getNumElements(); ++i) {
+                    if (!vec[i].is_object()) {
+                        error = "vector elements must be objects, got " + boost::json::serialize(vec[i]);
+                        return {};
+                    }
                     auto elem_vector = process_leaf_type(vector_type->getElementType(), vec[i].as_object(), is_private);
-                    ASSERT(!elem_vector.empty());
+                    if (elem_vector.empty()) {
+                        return {};
+                    }
                     res.insert(res.end(), elem_vector.begin(), elem_vector.end());
                 }
                 return res;
@@ -361,13 +560,20 @@ namespace nil {
             }
 
             ptr_type dispatch_type(llvm::Type *type, const boost::json::value &value, ptr_type ptr, bool is_private) {
+                if (!value.is_object()) {
+                    error = "input values must be objects, got " + boost::json::serialize(value);
+                    return 0;
+                }
                 switch (type->getTypeID()) {
                 case llvm::Type::GaloisFieldTyID:
                 case llvm::Type::EllipticCurveTyID:
                 case llvm::Type::IntegerTyID:
                 case llvm::Type::FixedVectorTyID:{
                     auto flat_components = process_leaf_type(type, value.as_object(), is_private);
-                    ASSERT(!flat_components.empty());
+                    if (flat_components.empty()) {
+                        // The error is set by the leaf processor
+                        return 0;
+                    }
                     for (auto num : flat_components) {
                         memory.store(ptr++, num);
                     }
@@ -385,83 +591,676 @@ namespace nil {
             }
 
             bool fill_public_input(const llvm::Function &function, const boost::json::array &public_input) {
-                size_t ret_gap = 0;
+                const input_plan &plan = get_plan(function);
+                if (public_input.size() != plan.values_amount) {
+                    error = "expected " + std::to_string(plan.values_amount) + " values in the input file, got " +
+                            std::to_string(public_input.size());
+                    return false;
+                }
+                reserve_cells(plan);
+
+                size_t value_idx = 0;
                 for (size_t i = 0; i < function.arg_size(); ++i) {
-                    if (public_input.size() <= i - ret_gap || !public_input[i - ret_gap].is_object()) {
-                        error = "not enough values in the input file.";
+                    const input_argument &argument = plan.arguments[i];
+                    llvm::Argument *current_arg = function.getArg(i);
+                    if (argument.kind == input_kind::struct_ret) {
+                        take_struct_ret(current_arg, argument);
+                        continue;
+                    }
+                    if (!public_input[value_idx].is_object()) {
+                        error = "malformed input file, every value must be an object";
+                        return false;
+                    }
+                    if (!take_argument(current_arg, argument, public_input[value_idx++].as_object())) {
                         return false;
                     }
+                }
+                return true;
+            }
 
+            // Same as above, but the values are decoded from the tokens of the stream following
+            // the function signature, no JSON value is built
+            bool fill_public_input(const llvm::Function &function, json_token_stream &public_input) {
+                if (!public_input.expect(json_token::kind_type::array_begin)) {
+                    error = "the input file must contain an array of values. " + public_input.get_error();
+                    return false;
+                }
+                const input_plan &plan = get_plan(function);
+                reserve_cells(plan);
+                for (size_t i = 0; i < function.arg_size(); ++i) {
+                    const input_argument &argument = plan.arguments[i];
                     llvm::Argument *current_arg = function.getArg(i);
-                    const boost::json::object &current_value = public_input[i - ret_gap].as_object();
-                    llvm::Type *arg_type = current_arg->getType();
+                    if (argument.kind == input_kind::struct_ret) {
+                        take_struct_ret(current_arg, argument);
+                        continue;
+                    }
+                    if (public_input.peek().kind != json_token::kind_type::object_begin) {
+                        error = "not enough values in the input file. " + public_input.get_error();
+                        return false;
+                    }
+                    if (!stream_argument(current_arg, argument, public_input)) {
+                        if (!public_input.get_error().empty()) {
+                            error += ". " + public_input.get_error();
+                        }
+                        return false;
+                    }
+                }
 
-                    bool is_private = current_arg->hasAttribute(llvm::Attribute::PrivateInput);
+                if (!public_input.expect(json_token::kind_type::array_end) ||
+                    public_input.peek().kind != json_token::kind_type::end) {
+                    error = "too many values in the input file";
+                    return false;
+                }
+                if (!public_input.get_error().empty()) {
+                    error = public_input.get_error();
+                    return false;
+                }
+                return true;
+            }
 
-                    if (llvm::isa<llvm::PointerType>(arg_type)) {
-                        if (current_arg->hasStructRetAttr()) {
-                            auto pointee = current_arg->getAttribute(llvm::Attribute::StructRet).getValueAsType();
-                            ptr_type ptr = memory.add_cells(layout_resolver.get_type_layout<BlueprintFieldType>(pointee));
-                            frame.scalars[current_arg] = put_into_assignment(ptr, is_private);
-                            ret_gap += 1;
-                            continue;
+            // Reads {"array": [...]} and {"struct": [...]} values token by token
+            ptr_type stream_type(llvm::Type *type, json_token_stream &input, ptr_type ptr, bool is_private) {
+                if (!type->isArrayTy() && !type->isStructTy()) {
+                    std::vector<var> values;
+                    if (!stream_leaf(type, input, is_private, values)) {
+                        return 0;
+                    }
+                    for (const var &v : values) {
+                        memory.store(ptr++, v);
+                    }
+                    return ptr;
+                }
+                std::string key;
+                if (!open_stream_value(input, key)) {
+                    return 0;
+                }
+                if (auto *struct_type = llvm::dyn_cast<llvm::StructType>(type)) {
+                    if (key == "array" && struct_type->getNumElements() == 1 &&
+                        struct_type->getElementType(0)->isArrayTy()) {
+                        // Assuming std::array
+                        type = struct_type->getElementType(0);
+                    } else if (key != "struct") {
+                        error = "expected {\"struct\": ...}, got {\"" + key + "\": ...}";
+                        return 0;
+                    }
+                } else if (key != "array") {
+                    error = "expected {\"array\": ...}, got {\"" + key + "\": ...}";
+                    return 0;
+                }
+
+                if (!input.expect(json_token::kind_type::array_begin)) {
+                    error = "the \"" + key + "\" value must be an array";
+                    return 0;
+                }
+                if (auto *array_type = llvm::dyn_cast<llvm::ArrayType>(type)) {
+                    if (is_bulk_element(array_type->getElementType())) {
+                        ptr = stream_bulk(array_type->getElementType(), array_type->getNumElements(), input, ptr, is_private);
+                    } else {
+                        for (size_t i = 0; i < array_type->getNumElements() && ptr != 0; ++i) {
+                            ptr = stream_type(array_type->getElementType(), input, ptr, is_private);
                         }
-                        if (current_arg->hasAttribute(llvm::Attribute::ByVal)) {
-                            auto pointee = current_arg->getAttribute(llvm::Attribute::ByVal).getValueAsType();
-                            if (pointee->isStructTy()) {
-                                if (try_struct(current_arg, llvm::cast<llvm::StructType>(pointee), current_value, is_private))
-                                    continue;
-                            } else if (pointee->isArrayTy()) {
-                                if (try_array(current_arg, llvm::cast<llvm::ArrayType>(pointee), current_value, is_private))
-                                    continue;
-                            } else {
-                                UNREACHABLE("unsupported pointer type");
-                            }
+                    }
+                } else {
+                    auto *struct_type = llvm::cast<llvm::StructType>(type);
+                    for (unsigned i = 0; i < struct_type->getNumElements() && ptr != 0; ++i) {
+                        ptr = stream_type(struct_type->getElementType(i), input, ptr, is_private);
+                    }
+                }
+                if (ptr == 0) {
+                    return 0;
+                }
+                if (!input.expect(json_token::kind_type::array_end)) {
+                    error = "too many elements in the \"" + key + "\" value";
+                    return 0;
+                }
+                if (!close_stream_value(input)) {
+                    return 0;
+                }
+                return ptr;
+            }
+
+            bool fill_public_input(const llvm::Function &function, binary_input &public_input) {
+                std::uint64_t values_amount = 0;
+                if (!public_input.read_header(values_amount)) {
+                    error = public_input.get_error();
+                    return false;
+                }
+                const input_plan &plan = get_plan(function);
+                if (values_amount != plan.values_amount) {
+                    error = "expected " + std::to_string(plan.values_amount) + " values in the input file, got " +
+                            std::to_string(values_amount);
+                    return false;
+                }
+                reserve_cells(plan);
+
+                for (size_t i = 0; i < function.arg_size(); ++i) {
+                    const input_argument &argument = plan.arguments[i];
+                    llvm::Argument *current_arg = function.getArg(i);
+                    if (argument.kind == input_kind::struct_ret) {
+                        take_struct_ret(current_arg, argument);
+                        continue;
+                    }
+                    if (!read_binary_argument(current_arg, argument, public_input)) {
+                        if (error.empty()) {
+                            error = public_input.get_error();
                         }
-                        if (!try_string(current_arg, arg_type, current_value, is_private)) {
-                            std::cerr << "Unhandled pointer argument" << std::endl;
+                        return false;
+                    }
+                }
+                if (!public_input.at_end()) {
+                    error = "unexpected data after the last value of the input file";
+                    return false;
+                }
+                return true;
+            }
+
+            size_t get_idx() const {
+                return public_input_idx;
+            }
+
+            size_t get_private_idx() const {
+                return private_input_idx;
+            }
+
+            const std::string &get_error() const {
+                return error;
+            }
+
+            // Decode long int and field arrays on the workers of the pool, without a pool the decoding is sequential
+            void set_thread_pool(detail::assignment_thread_pool *pool) {
+                thread_pool = pool;
+            }
+
+            // Use a plan compiled beforehand instead of compiling it for every input
+            void set_plan(const input_plan &plan) {
+                compiled_plan = &plan;
+            }
+
+        private:
+            const input_plan &get_plan(const llvm::Function &function) {
+                if (compiled_plan == nullptr || compiled_plan->function != &function) {
+                    own_plan = compile_input_plan<BlueprintFieldType>(function, layout_resolver);
+                    compiled_plan = &own_plan;
+                }
+                return *compiled_plan;
+            }
+
+            // Touch the last row each column will take, so the columns are resized once
+            void reserve_cells(const input_plan &plan) {
+                if (!plan.exact) {
+                    return;
+                }
+                typename BlueprintFieldType::value_type zero_val = 0;
+                if (plan.public_cells != 0) {
+                    assignmnt.public_input(0, public_input_idx + plan.public_cells - 1) = zero_val;
+                }
+                if (plan.private_cells != 0) {
+                    assignmnt.private_storage(private_input_idx + plan.private_cells - 1) = zero_val;
+                }
+            }
+
+            void take_struct_ret(llvm::Argument *current_arg, const input_argument &argument) {
+                ptr_type ptr = memory.add_cells(layout_resolver.get_type_layout<BlueprintFieldType>(argument.type));
+                frame.scalars[current_arg] = put_into_assignment(ptr, argument.is_private);
+            }
+
+            bool take_argument(llvm::Argument *current_arg, const input_argument &argument,
+                               const boost::json::object &current_value) {
+                bool is_private = argument.is_private;
+                switch (argument.kind) {
+                case input_kind::aggregate:
+                    if (argument.type->isStructTy()) {
+                        return try_struct(current_arg, llvm::cast<llvm::StructType>(argument.type), current_value, is_private);
+                    }
+                    return try_array(current_arg, llvm::cast<llvm::ArrayType>(argument.type), current_value, is_private);
+                case input_kind::string:
+                    if (!try_string(current_arg, argument.type, current_value, is_private)) {
+                        std::cerr << "Unhandled pointer argument" << std::endl;
+                        return false;
+                    }
+                    return true;
+                case input_kind::vector:
+                    return take_vector(current_arg, argument.type, current_value, is_private);
+                case input_kind::curve:
+                    return take_curve(current_arg, argument.type, current_value, is_private);
+                case input_kind::field:
+                    return take_field(current_arg, argument.type, current_value, is_private);
+                case input_kind::integer:
+                    return take_int(current_arg, current_value, is_private);
+                default:
+                    UNREACHABLE("unsupported input type");
+                }
+            }
+
+            bool stream_argument(llvm::Argument *current_arg, const input_argument &argument, json_token_stream &input) {
+                bool is_private = argument.is_private;
+                if (argument.kind == input_kind::aggregate) {
+                    ptr_type ptr = memory.add_cells(layout_resolver.get_type_layout<BlueprintFieldType>(argument.type));
+                    if (stream_type(argument.type, input, ptr, is_private) == 0) {
+                        return false;
+                    }
+                    frame.scalars[current_arg] = put_into_assignment(ptr, is_private);
+                    return true;
+                }
+                if (argument.kind == input_kind::string) {
+                    return stream_string(current_arg, input, is_private);
+                }
+                llvm::Type *arg_type = argument.type;
+                std::vector<var> values;
+                if (!stream_leaf(arg_type, input, is_private, values)) {
+                    return false;
+                }
+                if (values.size() == 1 && !arg_type->isVectorTy() && !arg_type->isCurveTy()) {
+                    frame.scalars[current_arg] = values[0];
+                } else {
+                    frame.vectors[current_arg] = values;
+                }
+                return true;
+            }
+
+            // Reads `{"key":` of a value, the payload and the closing brace are left in the stream
+            bool open_stream_value(json_token_stream &input, std::string &key) {
+                if (!input.expect(json_token::kind_type::object_begin)) {
+                    error = "malformed input value, expected an object";
+                    return false;
+                }
+                json_token key_token = input.next();
+                if (key_token.kind != json_token::kind_type::key) {
+                    error = "malformed input value, expected a key";
+                    return false;
+                }
+                key = std::move(key_token.text);
+                return true;
+            }
+
+            bool close_stream_value(json_token_stream &input) {
+                if (!input.expect(json_token::kind_type::object_end)) {
+                    error = "malformed input value, an object must have exactly one key";
+                    return false;
+                }
+                return true;
+            }
+
+            // Reads {"key": scalar}, the token keeps the text the decoded number refers to
+            bool stream_scalar(json_token_stream &input, const char *expected_key, json_token &token) {
+                std::string key;
+                if (!open_stream_value(input, key)) {
+                    return false;
+                }
+                if (key != expected_key) {
+                    error = std::string("expected {\"") + expected_key + "\": ...}, got {\"" + key + "\": ...}";
+                    return false;
+                }
+                token = input.next();
+                return close_stream_value(input);
+            }
+
+            bool stream_field(llvm::GaloisFieldKind field_kind, const json_token &token, std::size_t arg_len,
+                              bool is_private, std::vector<var> &values) {
+                std::vector<typename BlueprintFieldType::value_type> chunks;
+                if (!decode_field(input_number::from(token), field_kind, chunks, error)) {
+                    return false;
+                }
+                if (chunks.size() != arg_len) {
+                    error = "wrong field value " + input_number::from(token).to_string();
+                    return false;
+                }
+                auto field_values = put_field_into_assignmnt(chunks, is_private);
+                values.insert(values.end(), field_values.begin(), field_values.end());
+                return true;
+            }
+
+            bool stream_leaf(llvm::Type *type, json_token_stream &input, bool is_private, std::vector<var> &values) {
+                json_token token;
+                switch (type->getTypeID()) {
+                case llvm::Type::IntegerTyID: {
+                    typename BlueprintFieldType::value_type out;
+                    if (!stream_scalar(input, "int", token) ||
+                        !decode_int(input_number::from(token), type->getPrimitiveSizeInBits(), out, error)) {
+                        return false;
+                    }
+                    values.push_back(put_into_assignment(out, is_private));
+                    return true;
+                }
+                case llvm::Type::GaloisFieldTyID: {
+                    auto *field_type = llvm::cast<llvm::GaloisFieldType>(type);
+                    return stream_scalar(input, "field", token) &&
+                           stream_field(field_type->getFieldKind(), token, field_arg_num<BlueprintFieldType>(type),
+                                        is_private, values);
+                }
+                case llvm::Type::EllipticCurveTyID: {
+                    auto *curve_type = llvm::cast<llvm::EllipticCurveType>(type);
+                    std::size_t coordinate_len = curve_arg_num<BlueprintFieldType>(type) / 2;
+                    std::string key;
+                    if (!open_stream_value(input, key)) {
+                        return false;
+                    }
+                    if (key != "curve" || !input.expect(json_token::kind_type::array_begin)) {
+                        error = "expected {\"curve\": [x, y]}";
+                        return false;
+                    }
+                    // The point is given as two coordinates
+                    for (int i = 0; i < 2; ++i) {
+                        token = input.next();
+                        if (!stream_field(curve_type->GetBaseFieldKind(), token, coordinate_len, is_private, values)) {
                             return false;
                         }
-                    } else if (llvm::isa<llvm::FixedVectorType>(arg_type)) {
-                        if (!take_vector(current_arg, arg_type, current_value, is_private))
-                            return false;
-                    } else if (llvm::isa<llvm::EllipticCurveType>(arg_type)) {
-                        if (!take_curve(current_arg, arg_type, current_value, is_private))
+                    }
+                    if (!input.expect(json_token::kind_type::array_end)) {
+                        error = "curve element consists of two field elements";
+                        return false;
+                    }
+                    return close_stream_value(input);
+                }
+                case llvm::Type::FixedVectorTyID: {
+                    auto *vector_type = llvm::cast<llvm::FixedVectorType>(type);
+                    std::string key;
+                    if (!open_stream_value(input, key)) {
+                        return false;
+                    }
+                    if (key != "vector" || !input.expect(json_token::kind_type::array_begin)) {
+                        error = "expected {\"vector\": [...]}";
+                        return false;
+                    }
+                    for (unsigned i = 0; i < vector_type->getNumElements(); ++i) {
+                        if (!stream_leaf(vector_type->getElementType(), input, is_private, values)) {
                             return false;
-                    } else if (llvm::isa<llvm::GaloisFieldType>(arg_type)) {
-                        if (!take_field(current_arg, arg_type, current_value, is_private))
+                        }
+                    }
+                    if (!input.expect(json_token::kind_type::array_end)) {
+                        error = "too many elements in the \"vector\" value";
+                        return false;
+                    }
+                    return close_stream_value(input);
+                }
+                default:
+                    UNREACHABLE("Unexpected leaf type");
+                }
+            }
+
+            // The elements of int and field arrays are decoded into one buffer and stored at once
+            ptr_type stream_bulk(llvm::Type *elem_type, std::size_t elements_amount, json_token_stream &input,
+                                 ptr_type ptr, bool is_private) {
+                const bool is_field = elem_type->isFieldTy();
+                std::size_t bitness = is_field ? 0 : elem_type->getPrimitiveSizeInBits();
+                llvm::GaloisFieldKind field_kind = is_field ? llvm::cast<llvm::GaloisFieldType>(elem_type)->getFieldKind()
+                                                            : llvm::GaloisFieldKind();
+                std::size_t elem_len = is_field ? field_arg_num<BlueprintFieldType>(elem_type) : 1;
+
+                std::vector<typename BlueprintFieldType::value_type> values(elements_amount * elem_len);
+                std::vector<typename BlueprintFieldType::value_type> chunks;
+                json_token token;
+                for (std::size_t i = 0; i < elements_amount; ++i) {
+                    if (!stream_scalar(input, is_field ? "field" : "int", token)) {
+                        return 0;
+                    }
+                    if (!is_field) {
+                        if (!decode_int(input_number::from(token), bitness, values[i], error)) {
+                            return 0;
+                        }
+                        continue;
+                    }
+                    if (!decode_field(input_number::from(token), field_kind, chunks, error)) {
+                        return 0;
+                    }
+                    if (chunks.size() != elem_len) {
+                        error = "wrong field value " + input_number::from(token).to_string();
+                        return 0;
+                    }
+                    std::copy(chunks.begin(), chunks.end(), values.begin() + i * elem_len);
+                }
+                return store_bulk(values, ptr, is_private);
+            }
+
+            bool stream_string(llvm::Argument *arg, json_token_stream &input, bool is_private) {
+                json_token token;
+                if (!stream_scalar(input, "string", token)) {
+                    return false;
+                }
+                if (token.kind != json_token::kind_type::string) {
+                    error = "the \"string\" value must be a string";
+                    return false;
+                }
+                ptr_type ptr = memory.add_cells(std::vector<unsigned>(token.text.size() + 1, 1));
+                frame.scalars[arg] = put_into_assignment(ptr, is_private);
+                for (char c : token.text) {
+                    memory.store(ptr++, put_into_assignment(c, is_private));
+                }
+                // Put '\0' at the end
+                typename BlueprintFieldType::value_type zero_val = 0;
+                memory.store(ptr++, put_into_assignment(zero_val, is_private));
+                return true;
+            }
+
+            bool read_binary_argument(llvm::Argument *current_arg, const input_argument &argument, binary_input &input) {
+                bool is_private = argument.is_private;
+                if (argument.kind == input_kind::aggregate) {
+                    ptr_type ptr = memory.add_cells(layout_resolver.get_type_layout<BlueprintFieldType>(argument.type));
+                    ptr_type cur = ptr;
+                    if (!read_binary_type(argument.type, input, cur, is_private)) {
+                        return false;
+                    }
+                    frame.scalars[current_arg] = put_into_assignment(ptr, is_private);
+                    return true;
+                }
+                if (argument.kind == input_kind::string) {
+                    return read_binary_string(current_arg, input, is_private);
+                }
+                llvm::Type *arg_type = argument.type;
+                std::vector<var> values;
+                if (!read_binary_leaf(arg_type, input, is_private, values)) {
+                    return false;
+                }
+                if (values.size() == 1 && !arg_type->isVectorTy() && !arg_type->isCurveTy()) {
+                    frame.scalars[current_arg] = values[0];
+                } else {
+                    frame.vectors[current_arg] = values;
+                }
+                return true;
+            }
+
+            bool read_binary_string(llvm::Argument *arg, binary_input &input, bool is_private) {
+                std::uint64_t length = 0;
+                const std::uint8_t *bytes = nullptr;
+                if (!input.read_word(length) || (bytes = input.read_bytes(length)) == nullptr) {
+                    return false;
+                }
+                ptr_type ptr = memory.add_cells(std::vector<unsigned>(length + 1, 1));
+                frame.scalars[arg] = put_into_assignment(ptr, is_private);
+                for (std::uint64_t i = 0; i < length; i++) {
+                    char c = bytes[i];
+                    memory.store(ptr++, put_into_assignment(c, is_private));
+                }
+                // Put '\0' at the end
+                typename BlueprintFieldType::value_type zero_val = 0;
+                memory.store(ptr++, put_into_assignment(zero_val, is_private));
+                return true;
+            }
+
+            bool read_binary_type(llvm::Type *type, binary_input &input, ptr_type &ptr, bool is_private) {
+                if (!type->isArrayTy() && !type->isStructTy()) {
+                    std::vector<var> values;
+                    if (!read_binary_leaf(type, input, is_private, values)) {
+                        return false;
+                    }
+                    for (const var &v : values) {
+                        memory.store(ptr++, v);
+                    }
+                    return true;
+                }
+                std::uint64_t elements_amount = 0;
+                if (!input.read_word(elements_amount)) {
+                    return false;
+                }
+                if (auto *array_type = llvm::dyn_cast<llvm::ArrayType>(type)) {
+                    if (elements_amount != array_type->getNumElements()) {
+                        error = "wrong number of array elements in the input file";
+                        return false;
+                    }
+                    if (is_bulk_element(array_type->getElementType())) {
+                        return read_binary_bulk(array_type->getElementType(), elements_amount, input, ptr, is_private);
+                    }
+                    for (std::uint64_t i = 0; i < elements_amount; ++i) {
+                        if (!read_binary_type(array_type->getElementType(), input, ptr, is_private)) {
                             return false;
-                    } else if (llvm::isa<llvm::IntegerType>(arg_type)) {
-                        if (!take_int(current_arg, current_value, is_private))
+                        }
+                    }
+                    return true;
+                }
+                auto *struct_type = llvm::cast<llvm::StructType>(type);
+                if (elements_amount != struct_type->getNumElements()) {
+                    error = "wrong number of struct elements in the input file";
+                    return false;
+                }
+                for (unsigned i = 0; i < struct_type->getNumElements(); ++i) {
+                    if (!read_binary_type(struct_type->getElementType(i), input, ptr, is_private)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            // The elements of int and field arrays have a fixed size, so the whole array is taken at once
+            bool read_binary_bulk(llvm::Type *elem_type, std::uint64_t elements_amount, binary_input &input,
+                                  ptr_type &ptr, bool is_private) {
+                const bool is_field = elem_type->isFieldTy();
+                std::size_t bitness = elem_type->getPrimitiveSizeInBits();
+                if (!is_field) {
+                    ASSERT_MSG(bitness <= 128, "integers larger than 128 bits are not supported, try to use field types");
+                }
+                std::size_t words = is_field ? (layout_resolver.get_type_size(elem_type) + 7) / 8 : (bitness + 63) / 64;
+                const std::uint8_t *bytes = input.read_bytes(elements_amount * words * 8);
+                if (bytes == nullptr) {
+                    return false;
+                }
+
+                std::vector<typename BlueprintFieldType::value_type> values;
+                values.reserve(elements_amount);
+                typename BlueprintFieldType::extended_integral_type number;
+                typename BlueprintFieldType::extended_integral_type one = 1;
+                typename BlueprintFieldType::extended_integral_type max_size = is_field ? 0 : one << bitness;
+                llvm::GaloisFieldKind field_kind = is_field ? llvm::cast<llvm::GaloisFieldType>(elem_type)->getFieldKind()
+                                                            : llvm::GaloisFieldKind();
+                for (std::uint64_t i = 0; i < elements_amount; ++i, bytes += words * 8) {
+                    load_binary_number(bytes, words, number);
+                    if (!is_field) {
+                        if (number >= max_size) {
+                            error = "one of the input values does not fit into " + std::to_string(bitness) + " bits";
                             return false;
+                        }
+                        typename BlueprintFieldType::value_type out = number;
+                        values.push_back(out);
+                        continue;
                     }
-                    else {
-                        UNREACHABLE("unsupported input type");
+                    if (!fits_field_modulus<BlueprintFieldType>(field_kind, number)) {
+                        error = "one of the field elements does not fit into the field modulus";
+                        return false;
                     }
+                    auto chunks = extended_integral_into_vector<BlueprintFieldType>(field_kind, number);
+                    values.insert(values.end(), chunks.begin(), chunks.end());
                 }
+                ptr = store_bulk(values, ptr, is_private);
+                return true;
+            }
 
-                // Check if there are remaining elements of public input
-                if (function.arg_size() - ret_gap != public_input.size()) {
-                    error = "too many values in the input file";
+            bool read_binary_leaf(llvm::Type *type, binary_input &input, bool is_private, std::vector<var> &values) {
+                switch (type->getTypeID()) {
+                case llvm::Type::IntegerTyID: {
+                    std::size_t bitness = type->getPrimitiveSizeInBits();
+                    ASSERT_MSG(bitness <= 128, "integers larger than 128 bits are not supported, try to use field types");
+                    typename BlueprintFieldType::extended_integral_type number;
+                    if (!read_binary_number(input, (bitness + 63) / 64, number)) {
+                        return false;
+                    }
+                    typename BlueprintFieldType::extended_integral_type one = 1;
+                    if (number >= (one << bitness)) {
+                        error = "one of the input values does not fit into " + std::to_string(bitness) + " bits";
+                        return false;
+                    }
+                    typename BlueprintFieldType::value_type out = number;
+                    values.push_back(put_into_assignment(out, is_private));
+                    return true;
+                }
+                case llvm::Type::GaloisFieldTyID: {
+                    auto *field_type = llvm::cast<llvm::GaloisFieldType>(type);
+                    std::size_t words = (layout_resolver.get_type_size(type) + 7) / 8;
+                    return read_binary_field(field_type->getFieldKind(), words, input, is_private, values);
+                }
+                case llvm::Type::EllipticCurveTyID: {
+                    auto *curve_type = llvm::cast<llvm::EllipticCurveType>(type);
+                    // The point is stored as two coordinates
+                    std::size_t words = (layout_resolver.get_type_size(type) / 2 + 7) / 8;
+                    return read_binary_field(curve_type->GetBaseFieldKind(), words, input, is_private, values) &&
+                           read_binary_field(curve_type->GetBaseFieldKind(), words, input, is_private, values);
+                }
+                case llvm::Type::FixedVectorTyID: {
+                    auto *vector_type = llvm::cast<llvm::FixedVectorType>(type);
+                    std::uint64_t elements_amount = 0;
+                    if (!input.read_word(elements_amount)) {
+                        return false;
+                    }
+                    if (elements_amount != vector_type->getNumElements()) {
+                        error = "wrong number of vector elements in the input file";
+                        return false;
+                    }
+                    for (std::uint64_t i = 0; i < elements_amount; ++i) {
+                        if (!read_binary_leaf(vector_type->getElementType(), input, is_private, values)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                default:
+                    UNREACHABLE("Unexpected leaf type");
+                }
+            }
+
+            bool read_binary_field(llvm::GaloisFieldKind field_kind, std::size_t words, binary_input &input,
+                                   bool is_private, std::vector<var> &values) {
+                typename BlueprintFieldType::extended_integral_type number;
+                if (!read_binary_number(input, words, number)) {
+                    return false;
+                }
+                if (!fits_field_modulus<BlueprintFieldType>(field_kind, number)) {
+                    error = "one of the field elements does not fit into the field modulus";
                     return false;
                 }
+                auto chunks = extended_integral_into_vector<BlueprintFieldType>(field_kind, number);
+                auto field_values = put_field_into_assignmnt(chunks, is_private);
+                values.insert(values.end(), field_values.begin(), field_values.end());
                 return true;
             }
-            size_t get_idx() const {
-                return public_input_idx;
+
+            bool read_binary_number(binary_input &input, std::size_t words,
+                                    typename BlueprintFieldType::extended_integral_type &number) {
+                const std::uint8_t *bytes = input.read_bytes(words * 8);
+                if (bytes == nullptr) {
+                    return false;
+                }
+                load_binary_number(bytes, words, number);
+                return true;
             }
 
-            const std::string &get_error() const {
-                return error;
+            static void load_binary_number(const std::uint8_t *bytes, std::size_t words,
+                                           typename BlueprintFieldType::extended_integral_type &number) {
+                number = 0;
+                for (std::size_t i = words; i-- > 0;) {
+                    number <<= 64;
+                    number += binary_input::load_word(bytes + 8 * i);
+                }
             }
 
-        private:
             stack_frame<var> &frame;
             program_memory<var> &memory;
             Assignment &assignmnt;
             LayoutResolver &layout_resolver;
             size_t public_input_idx;
             size_t private_input_idx;
+            detail::assignment_thread_pool *thread_pool = nullptr;
+            const input_plan *compiled_plan = nullptr;
+            input_plan own_plan;
+            // Elements decoded by one task of the pool, shorter arrays are decoded inline
+            static constexpr std::size_t bulk_chunk_size = 4096;
             std::string error;
         };
     }   // namespace blueprint
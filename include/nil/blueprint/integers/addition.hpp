@@ -37,31 +37,30 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
 
 namespace nil {
     namespace blueprint {
 
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_integer_addition_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row, bool next_prover) {
 
             using non_native_policy_type = basic_non_native_policy<BlueprintFieldType>;
 
-            llvm::Value *operand0 = inst->getOperand(0);
-            llvm::Value *operand1 = inst->getOperand(1);
-
             const auto res = detail::handle_native_field_addition_component<BlueprintFieldType, ArithmetizationParams>(
-                                operand0, operand1, frame.scalars, bp, assignment, start_row)
+                                op.operands[0], op.operands[1], frame.scalars, bp, assignment, context, start_row)
                                 .output;
             if (next_prover) {
-                frame.scalars[inst] = save_shared_var(assignment, res);
+                frame.scalars.at_slot(op.result) = save_shared_var(assignment, res);
             } else {
-                frame.scalars[inst] = res;
+                frame.scalars.at_slot(op.result) = res;
             }
         }
 
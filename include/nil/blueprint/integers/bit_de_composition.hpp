@@ -37,6 +37,8 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 #include <nil/blueprint/non_native_marshalling.hpp>
 #include <nil/blueprint/policy/policy_manager.hpp>
 
@@ -47,32 +49,32 @@ namespace nil {
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_native_field_decomposition_component(
             std::size_t BitsAmount,
-            llvm::Value *result_value,
-            llvm::Value *input,
+            std::uint32_t result_value,
+            std::uint32_t input,
             bool is_msb,
-            typename std::map<const llvm::Value *, std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
-            typename std::map<const llvm::Value *, crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
+            value_storage<std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
+            value_storage<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
             program_memory<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &memory,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row) {
 
             using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
-            var component_input = variables[input];
+            var component_input = variables.at_slot(input);
 
             using mode = nil::blueprint::components::bit_composition_mode;
             mode Mode = is_msb ? mode::MSB : mode::LSB;
 
             using component_type = nil::blueprint::components::bit_decomposition<
                 crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>;
-            const auto p = PolicyManager::get_parameters(ManifestReader<component_type, ArithmetizationParams>::get_witness(0, BitsAmount));
-            component_type component_instance =  component_type(p.witness, ManifestReader<component_type, ArithmetizationParams>::get_constants(), ManifestReader<component_type, ArithmetizationParams>::get_public_inputs(), BitsAmount, Mode);
+            const component_type &component_instance = ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0, BitsAmount), BitsAmount, Mode);
 
-            components::generate_circuit(component_instance, bp, assignment, {component_input}, start_row);
-            auto result = components::generate_assignments(component_instance, assignment, {component_input}, start_row).output;
+            detail::generate_circuit(component_instance, bp, assignment, context, {component_input}, start_row);
+            auto result = detail::generate_assignments(component_instance, assignment, context, {component_input}, start_row).output;
             ptr_type result_ptr = static_cast<ptr_type>(
-                typename BlueprintFieldType::integral_type(var_value(assignment, variables[result_value]).data));
+                typename BlueprintFieldType::integral_type(var_value(assignment, variables.at_slot(result_value)).data));
             for (var v : result) {
                 ASSERT(memory[result_ptr].size == (BlueprintFieldType::number_bits + 7) / 8);
                 memory.store(result_ptr++, v);
@@ -83,15 +85,16 @@ namespace nil {
         typename components::bit_composition<
         crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>::result_type
             handle_native_field_bit_composition_component(
-            llvm::Value *input_value,
+            std::uint32_t input_value,
             llvm::Value *bitness_value,
             llvm::Value *operand_sig_bit,
-            typename std::map<const llvm::Value *, std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
-            typename std::map<const llvm::Value *, crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
+            value_storage<std::vector<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>>> &vectors,
+            value_storage<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
             program_memory<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &memory,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row) {
 
             using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
@@ -111,35 +114,34 @@ namespace nil {
 
             std::vector<var> component_input = {};
             ptr_type component_input_ptr = static_cast<ptr_type>(
-                typename BlueprintFieldType::integral_type(var_value(assignment, variables[input_value]).data));
+                typename BlueprintFieldType::integral_type(var_value(assignment, variables.at_slot(input_value)).data));
             for(std::size_t i = 0; i < bitness_from_intrinsic; i++) {
                     ASSERT(memory[component_input_ptr].size == (BlueprintFieldType::number_bits + 7) / 8);
                     component_input.push_back(memory.load(component_input_ptr++));
             }
 
 
-            const auto p = PolicyManager::get_parameters(ManifestReader<component_type, ArithmetizationParams>::get_witness(0, bitness_from_intrinsic, true));
-            component_type component_instance =  component_type(p.witness, ManifestReader<component_type, ArithmetizationParams>::get_constants(), ManifestReader<component_type, ArithmetizationParams>::get_public_inputs(), bitness_from_intrinsic, true, Mode);
+            const component_type &component_instance = ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0, bitness_from_intrinsic, true), bitness_from_intrinsic, true, Mode);
 
-            components::generate_circuit(component_instance, bp, assignment, {component_input}, start_row);
-            return components::generate_assignments(component_instance, assignment, {component_input}, start_row);
+            detail::generate_circuit(component_instance, bp, assignment, context, {component_input}, start_row);
+            return detail::generate_assignments(component_instance, assignment, context, {component_input}, start_row);
 
             }
         }    // namespace detail
 
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_integer_bit_decomposition_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             program_memory<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &memory,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
-            llvm::Value *result_value = inst->getOperand(0);
             llvm::Value *bitness_value = inst->getOperand(1);
-            llvm::Value *input = inst->getOperand(2);
             llvm::Value *operand_sig_bit = inst->getOperand(3);
 
             auto marshalling_output_vector = marshal_field_val<BlueprintFieldType>(bitness_value);
@@ -153,32 +155,33 @@ namespace nil {
                 static_cast<bool>(typename BlueprintFieldType::integral_type(sig_bit_marshalled[0].data));
 
             detail::handle_native_field_decomposition_component<BlueprintFieldType, ArithmetizationParams>(
-                                bitness_from_intrinsic, result_value, input, is_msb, frame.vectors, frame.scalars, memory, bp, assignment, start_row);
+                                bitness_from_intrinsic, op.operands[0], op.operands[2], is_msb, frame.vectors, frame.scalars, memory, bp, assignment, context, start_row);
         }
 
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_integer_bit_composition_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             program_memory<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &memory,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
             using non_native_policy_type = basic_non_native_policy<BlueprintFieldType>;
 
-            llvm::Value *result_value = inst->getOperand(0);
             llvm::Value *bitness_value = inst->getOperand(1);
             llvm::Value *operand_sig_bit = inst->getOperand(2);
 
             const auto res = detail::handle_native_field_bit_composition_component<BlueprintFieldType, ArithmetizationParams>(
-                                result_value, bitness_value, operand_sig_bit, frame.vectors, frame.scalars, memory,  bp, assignment, start_row).output;
+                                op.operands[0], bitness_value, operand_sig_bit, frame.vectors, frame.scalars, memory,  bp, assignment, context, start_row).output;
 
             if (next_prover) {
-                frame.scalars[inst] = save_shared_var(assignment, res);
+                frame.scalars.at_slot(op.result) = save_shared_var(assignment, res);
             } else {
-                frame.scalars[inst] = res;
+                frame.scalars.at_slot(op.result) = res;
             }
         }
 
@@ -36,6 +36,8 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 #include <nil/blueprint/policy/policy_manager.hpp>
 
 
@@ -48,18 +50,19 @@ namespace nil {
         crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>::result_type
             handle_native_field_bit_shift_constant_component(
             std::size_t Bitness,
-            llvm::Value *operand0, llvm::Value *operand1,
-            typename std::map<const llvm::Value *, crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
+            std::uint32_t operand0, std::uint32_t operand1,
+            value_storage<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row,
             typename nil::blueprint::components::bit_shift_mode left_or_right) {
 
             using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
 
-            var x = variables[operand0];
-            var shift_var = variables[operand1];
+            var x = variables.at_slot(operand0);
+            var shift_var = variables.at_slot(operand1);
 
             //TODO: Shift should be input of the component, not as done there
             std::size_t Shift = std::size_t(typename BlueprintFieldType::integral_type(var_value(assignment, shift_var).data));
@@ -69,25 +72,25 @@ namespace nil {
 
             using nil::blueprint::components::bit_shift_mode;
 
-            const auto p = PolicyManager::get_parameters(ManifestReader<component_type, ArithmetizationParams>::get_witness(0, Bitness, Shift, left_or_right));
+            const component_type &component_instance = ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0, Bitness, Shift, left_or_right), Bitness, Shift, left_or_right);
 
-            component_type component_instance(p.witness, ManifestReader<component_type, ArithmetizationParams>::get_constants(), ManifestReader<component_type, ArithmetizationParams>::get_public_inputs(), Bitness, Shift, left_or_right);
 
-
-            components::generate_circuit(component_instance, bp, assignment, {x}, start_row);
-            return components::generate_assignments(component_instance, assignment, {x}, start_row);
+            detail::generate_circuit(component_instance, bp, assignment, context, {x}, start_row);
+            return detail::generate_assignments(component_instance, assignment, context, {x}, start_row);
             }
         }    // namespace detail
 
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_integer_bit_shift_constant_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row,
             typename nil::blueprint::components::bit_shift_mode left_or_right, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
             llvm::Value *operand0 = inst->getOperand(0);
             llvm::Value *operand1 = inst->getOperand(1);
@@ -97,11 +100,11 @@ namespace nil {
             std::size_t bitness = inst->getOperand(0)->getType()->getPrimitiveSizeInBits();
 
             const auto res = detail::handle_native_field_bit_shift_constant_component<BlueprintFieldType, ArithmetizationParams>(
-                                bitness, operand0, operand1, frame.scalars, bp, assignment, start_row, left_or_right).output;
+                                bitness, op.operands[0], op.operands[1], frame.scalars, bp, assignment, context, start_row, left_or_right).output;
             if (next_prover) {
-                frame.scalars[inst] = save_shared_var(assignment, res);
+                frame.scalars.at_slot(op.result) = save_shared_var(assignment, res);
             } else {
-                frame.scalars[inst] = res;
+                frame.scalars.at_slot(op.result) = res;
             }
         }
 
@@ -36,6 +36,8 @@
 
 #include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/stack.hpp>
+#include <nil/blueprint/decoded_program.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 #include <nil/blueprint/policy/policy_manager.hpp>
 
 namespace nil {
@@ -49,37 +51,39 @@ namespace nil {
         crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>::result_type
             handle_native_field_division_remainder_component(
             std::size_t Bitness,
-            llvm::Value *operand0, llvm::Value *operand1,
-            typename std::map<const llvm::Value *, crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
+            std::uint32_t operand0, std::uint32_t operand1,
+            value_storage<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &variables,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row) {
 
             using var = crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>;
             using component_type = components::division_remainder<
                 crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>;
-            const auto p = PolicyManager::get_parameters(ManifestReader<component_type, ArithmetizationParams>::get_witness(0, Bitness, true));
-            component_type component_instance(p.witness, ManifestReader<component_type, ArithmetizationParams>::get_constants(), ManifestReader<component_type, ArithmetizationParams>::get_public_inputs(), Bitness, true);
+            const component_type &component_instance = ComponentCache<component_type, ArithmetizationParams>::get(context.components, std::make_tuple(0, Bitness, true), Bitness, true);
 
-            var x = variables[operand0];
-            var y = variables[operand1];
+            var x = variables.at_slot(operand0);
+            var y = variables.at_slot(operand1);
 
-            components::generate_circuit(component_instance, bp, assignment, {x, y}, start_row);
-            return components::generate_assignments(component_instance, assignment, {x, y}, start_row);
+            detail::generate_circuit(component_instance, bp, assignment, context, {x, y}, start_row);
+            return detail::generate_assignments(component_instance, assignment, context, {x, y}, start_row);
 
             }
         }    // namespace detail
 
         template<typename BlueprintFieldType, typename ArithmetizationParams>
         void handle_integer_division_remainder_component(
-            const llvm::Instruction *inst,
+            const decoded_instruction &op,
             stack_frame<crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type>> &frame,
             circuit_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &bp,
             assignment_proxy<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>>
                 &assignment,
+            detail::generation_context<crypto3::zk::snark::plonk_constraint_system<BlueprintFieldType, ArithmetizationParams>> &context,
             std::uint32_t start_row,
             bool is_division, bool next_prover) {
+            const llvm::Instruction *inst = op.inst;
 
             using non_native_policy_type = basic_non_native_policy<BlueprintFieldType>;
 
@@ -93,16 +97,16 @@ namespace nil {
             crypto3::zk::snark::plonk_variable<typename BlueprintFieldType::value_type> res;
             if (is_division) {
                 res = detail::handle_native_field_division_remainder_component<BlueprintFieldType, ArithmetizationParams>(
-                                bitness, operand0, operand1, frame.scalars, bp, assignment, start_row).quotient;
+                                bitness, op.operands[0], op.operands[1], frame.scalars, bp, assignment, context, start_row).quotient;
             }
             else {
                 res = detail::handle_native_field_division_remainder_component<BlueprintFieldType, ArithmetizationParams>(
-                                bitness, operand0, operand1, frame.scalars, bp, assignment, start_row).remainder;
+                                bitness, op.operands[0], op.operands[1], frame.scalars, bp, assignment, context, start_row).remainder;
             }
             if (next_prover) {
-                frame.scalars[inst] = save_shared_var(assignment, res);
+                frame.scalars.at_slot(op.result) = save_shared_var(assignment, res);
             } else {
-                frame.scalars[inst] = res;
+                frame.scalars.at_slot(op.result) = res;
             }
         }
 
@@ -0,0 +1,218 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_JSON_TOKEN_STREAM_HPP
+#define CRYPTO3_ASSIGNER_JSON_TOKEN_STREAM_HPP
+
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/json/basic_parser_impl.hpp>
+
+namespace nil {
+    namespace blueprint {
+        struct json_token {
+            enum class kind_type {
+                array_begin,
+                array_end,
+                object_begin,
+                object_end,
+                key,
+                string,
+                int64,
+                uint64,
+                double_,
+                boolean,
+                null,
+                // No more tokens: the document is over or the input is malformed, see get_error()
+                end,
+            };
+
+            kind_type kind;
+            std::string text;
+            std::int64_t int64 = 0;
+            std::uint64_t uint64 = 0;
+            double double_ = 0;
+            bool boolean = false;
+        };
+
+        // Pulls the tokens of a JSON document from a stream. The input is parsed incrementally by chunks,
+        // so only the tokens of one chunk are kept in memory, the document is never built
+        class json_token_stream {
+            struct handler {
+                constexpr static std::size_t max_object_size = std::size_t(-1);
+                constexpr static std::size_t max_array_size = std::size_t(-1);
+                constexpr static std::size_t max_key_size = std::size_t(-1);
+                constexpr static std::size_t max_string_size = std::size_t(-1);
+
+                explicit handler(std::deque<json_token> *tokens) : tokens(tokens) {}
+
+                bool on_document_begin(boost::json::error_code &) {
+                    return true;
+                }
+                bool on_document_end(boost::json::error_code &) {
+                    return true;
+                }
+                bool on_array_begin(boost::json::error_code &) {
+                    return push(json_token::kind_type::array_begin);
+                }
+                bool on_array_end(std::size_t, boost::json::error_code &) {
+                    return push(json_token::kind_type::array_end);
+                }
+                bool on_object_begin(boost::json::error_code &) {
+                    return push(json_token::kind_type::object_begin);
+                }
+                bool on_object_end(std::size_t, boost::json::error_code &) {
+                    return push(json_token::kind_type::object_end);
+                }
+                bool on_string_part(boost::json::string_view s, std::size_t, boost::json::error_code &) {
+                    partial.append(s.data(), s.size());
+                    return true;
+                }
+                bool on_string(boost::json::string_view s, std::size_t, boost::json::error_code &) {
+                    return push_text(json_token::kind_type::string, s);
+                }
+                bool on_key_part(boost::json::string_view s, std::size_t, boost::json::error_code &) {
+                    partial.append(s.data(), s.size());
+                    return true;
+                }
+                bool on_key(boost::json::string_view s, std::size_t, boost::json::error_code &) {
+                    return push_text(json_token::kind_type::key, s);
+                }
+                bool on_number_part(boost::json::string_view, boost::json::error_code &) {
+                    return true;
+                }
+                bool on_int64(std::int64_t i, boost::json::string_view, boost::json::error_code &) {
+                    push(json_token::kind_type::int64);
+                    tokens->back().int64 = i;
+                    return true;
+                }
+                bool on_uint64(std::uint64_t u, boost::json::string_view, boost::json::error_code &) {
+                    push(json_token::kind_type::uint64);
+                    tokens->back().uint64 = u;
+                    return true;
+                }
+                bool on_double(double d, boost::json::string_view, boost::json::error_code &) {
+                    push(json_token::kind_type::double_);
+                    tokens->back().double_ = d;
+                    return true;
+                }
+                bool on_bool(bool b, boost::json::error_code &) {
+                    push(json_token::kind_type::boolean);
+                    tokens->back().boolean = b;
+                    return true;
+                }
+                bool on_null(boost::json::error_code &) {
+                    return push(json_token::kind_type::null);
+                }
+                bool on_comment_part(boost::json::string_view, boost::json::error_code &) {
+                    return true;
+                }
+                bool on_comment(boost::json::string_view, boost::json::error_code &) {
+                    return true;
+                }
+
+                bool push(json_token::kind_type kind) {
+                    tokens->push_back({kind});
+                    return true;
+                }
+
+                bool push_text(json_token::kind_type kind, boost::json::string_view s) {
+                    push(kind);
+                    partial.append(s.data(), s.size());
+                    tokens->back().text = std::move(partial);
+                    partial.clear();
+                    return true;
+                }
+
+                std::deque<json_token> *tokens;
+                std::string partial;
+            };
+
+        public:
+            json_token_stream(std::istream &input, std::size_t chunk_size = 1 << 16) :
+                input(input), chunk(chunk_size), parser(boost::json::parse_options(), &tokens) {
+            }
+
+            json_token_stream(const json_token_stream &) = delete;
+            json_token_stream &operator=(const json_token_stream &) = delete;
+
+            const json_token &peek() {
+                while (tokens.empty()) {
+                    fill();
+                }
+                return tokens.front();
+            }
+
+            json_token next() {
+                json_token res = peek();
+                if (res.kind != json_token::kind_type::end) {
+                    tokens.pop_front();
+                }
+                return res;
+            }
+
+            bool expect(json_token::kind_type kind) {
+                return next().kind == kind;
+            }
+
+            const std::string &get_error() const {
+                return error;
+            }
+
+        private:
+            void fill() {
+                if (finished) {
+                    tokens.push_back({json_token::kind_type::end});
+                    return;
+                }
+                input.read(chunk.data(), chunk.size());
+                std::size_t read = input.gcount();
+                bool more = static_cast<bool>(input);
+                boost::json::error_code ec;
+                parser.write_some(more, chunk.data(), read, ec);
+                if (ec) {
+                    error = ec.message();
+                    finished = true;
+                } else if (!more) {
+                    finished = true;
+                }
+            }
+
+            std::istream &input;
+            std::vector<char> chunk;
+            std::deque<json_token> tokens;
+            boost::json::basic_parser<handler> parser;
+            bool finished = false;
+            std::string error;
+        };
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_JSON_TOKEN_STREAM_HPP
@@ -44,6 +44,7 @@
 #include "nil/crypto3/algebra/fields/pallas/base_field.hpp"
 
 #include <nil/blueprint/asserts.hpp>
+#include <nil/blueprint/memory.hpp>
 
 template<typename BlueprintFieldType>
         std::size_t curve_arg_num(llvm::Type *arg_type) {
@@ -119,6 +120,17 @@ namespace nil {
                 std::vector<Element> indices;
                 unsigned size;
                 unsigned width;
+                // Elements of arrays and vectors are equally spaced, so only the element type is kept
+                const llvm::Type *elem_type = nullptr;
+                unsigned elem_size = 0;
+                unsigned elem_width = 0;
+
+                Element element(unsigned i) const {
+                    if (elem_type != nullptr) {
+                        return {elem_type, i * elem_size, i * elem_width};
+                    }
+                    return indices[i];
+                }
             };
 
         public:
@@ -131,71 +143,71 @@ namespace nil {
                     resolve_type<BlueprintFieldType>(type);
                 auto *type_record = &type_cache[type];
                 for (unsigned i = 0; i < gep_indices.size() - 1; ++i) {
-                    offset += type_record->indices[gep_indices[i]].offset;
-                    type_record = &type_cache[type_record->indices[gep_indices[i]].type];
+                    Element element = type_record->element(gep_indices[i]);
+                    offset += element.offset;
+                    type_record = &type_cache[element.type];
                 }
-                return {type_record->indices[gep_indices.back()].offset + offset, type_record->indices[gep_indices.back()].idx};
+                Element last = type_record->element(gep_indices.back());
+                return {last.offset + offset, last.idx};
             }
 
             unsigned get_type_size(llvm::Type *type) {
                 return layout.getTypeStoreSize(type);
             }
 
+            // The layout is built once per type, size() of it is the number of cells
             template <typename BlueprintFieldType>
-            std::vector<unsigned> get_type_layout(llvm::Type *type) {
-                // TODO(maksenov): add type cache
+            const cell_layout &get_type_layout(llvm::Type *type) {
+                auto cached = layout_cache.find(type);
+                if (cached != layout_cache.end()) {
+                    return cached->second;
+                }
+                cell_layout res;
                 switch (type->getTypeID()) {
                 case llvm::Type::IntegerTyID:
                 case llvm::Type::PointerTyID:
-                    return {get_type_size(type)};
-                case llvm::Type::GaloisFieldTyID: {
-                    std::vector<unsigned> res;
-                    res.push_back(get_type_size(type));
-                    for (int i = 1; i < field_arg_num<BlueprintFieldType>(type); ++i) {
-                        res.push_back(0);
-                    }
-                    return res;
-                }
-                case llvm::Type::EllipticCurveTyID: {
-                    std::vector<unsigned> res;
-                    res.push_back(get_type_size(type));
-                    for (int i = 1; i < curve_arg_num<BlueprintFieldType>(type); ++i) {
-                        res.push_back(0);
-                    }
-                    return res;
-                }
+                    res.append(get_type_size(type), 1);
+                    break;
+                case llvm::Type::GaloisFieldTyID:
+                    res.append(get_type_size(type), 1);
+                    res.append(0, field_arg_num<BlueprintFieldType>(type) - 1);
+                    break;
+                case llvm::Type::EllipticCurveTyID:
+                    res.append(get_type_size(type), 1);
+                    res.append(0, curve_arg_num<BlueprintFieldType>(type) - 1);
+                    break;
                 case llvm::Type::StructTyID: {
                     auto *struct_ty = llvm::cast<llvm::StructType>(type);
-                    std::vector<unsigned> res;
                     for (size_t i = 0; i < struct_ty->getNumElements(); ++i) {
-                        auto offf = get_type_layout<BlueprintFieldType>(struct_ty->getElementType(i));
-                        res.insert(res.end(), offf.begin(), offf.end());
+                        res.append(get_type_layout<BlueprintFieldType>(struct_ty->getElementType(i)));
                     }
-                    return res;
-                }
-                case llvm::Type::ArrayTyID: {
-                    auto *array_ty = llvm::cast<llvm::ArrayType>(type);
-                    llvm::Type *elem_ty = array_ty->getElementType();
-                    std::vector<unsigned> elem_layout = get_type_layout<BlueprintFieldType>(elem_ty);
-                    std::vector<unsigned> res;
-                    for (size_t i = 0; i < array_ty->getNumElements(); ++i) {
-                        res.insert(res.end(), elem_layout.begin(), elem_layout.end());
-                    }
-                    return res;
+                    break;
                 }
+                case llvm::Type::ArrayTyID:
                 case llvm::Type::FixedVectorTyID: {
-                    auto *vec_ty = llvm::cast<llvm::FixedVectorType>(type);
-                    llvm::Type *elem_ty = vec_ty->getElementType();
-                    std::vector<unsigned> elem_layout = get_type_layout<BlueprintFieldType>(elem_ty);
-                    std::vector<unsigned> res;
-                    for (size_t i = 0; i < vec_ty->getNumElements(); ++i) {
-                        res.insert(res.end(), elem_layout.begin(), elem_layout.end());
+                    llvm::Type *elem_ty = nullptr;
+                    unsigned num_elements = 0;
+                    if (auto *array_ty = llvm::dyn_cast<llvm::ArrayType>(type)) {
+                        elem_ty = array_ty->getElementType();
+                        num_elements = array_ty->getNumElements();
+                    } else {
+                        auto *vec_ty = llvm::cast<llvm::FixedVectorType>(type);
+                        elem_ty = vec_ty->getElementType();
+                        num_elements = vec_ty->getNumElements();
+                    }
+                    const cell_layout &elem_layout = get_type_layout<BlueprintFieldType>(elem_ty);
+                    if (elem_layout.runs.size() == 1) {
+                        res.append(elem_layout.runs[0].first, elem_layout.size() * num_elements);
+                    } else {
+                        res.append(elem_layout);
+                        res.repeat = num_elements;
                     }
-                    return res;
+                    break;
                 }
                 default:
                     UNREACHABLE("Unsupported type");
                 }
+                return layout_cache.emplace(type, std::move(res)).first->second;
             }
 
             LayoutResolver(const LayoutResolver &) = delete;
@@ -229,12 +241,9 @@ namespace nil {
                     size_t elem_width = get_type_size(elem_ty);
                     cache_data.size = array_ty->getNumElements() * elem_size;
                     cache_data.width = array_ty->getNumElements() * elem_width;
-                    cache_data.indices.resize(array_ty->getNumElements());
-                    for (unsigned i = 0; i < array_ty->getNumElements(); ++i) {
-                        cache_data.indices[i].idx = i * elem_size;
-                        cache_data.indices[i].type = elem_ty;
-                        cache_data.indices[i].offset = i * elem_width;
-                    }
+                    cache_data.elem_type = elem_ty;
+                    cache_data.elem_size = elem_size;
+                    cache_data.elem_width = elem_width;
                     break;
                 }
                 case llvm::Type::StructTyID: {
@@ -261,6 +270,9 @@ namespace nil {
                     unsigned elem_size = resolved_element.size;
                     cache_data.size = vector_ty->getNumElements() * elem_size;
                     cache_data.width = vector_ty->getNumElements() * resolved_element.width;
+                    cache_data.elem_type = elem_ty;
+                    cache_data.elem_size = elem_size;
+                    cache_data.elem_width = resolved_element.width;
                     break;
                 }
                 default:
@@ -270,6 +282,7 @@ namespace nil {
                 return type_cache[type];
             }
             std::unordered_map<const llvm::Type *, IndexMapping> type_cache;
+            std::unordered_map<const llvm::Type *, cell_layout> layout_cache;
             const llvm::DataLayout &layout;
         };
     }
@@ -30,7 +30,12 @@
 #include <unordered_map>
 #include <vector>
 #include <stack>
+#include <array>
+#include <map>
+#include <memory>
+#include <set>
 #include <algorithm>
+#include <iterator>
 
 #include <nil/blueprint/asserts.hpp>
 
@@ -41,23 +46,149 @@ namespace nil {
         template<typename VarType>
         struct cell {
             VarType v;
-            size_t offset;
+            ptr_type offset;
             int8_t size;
         };
 
+        // Sizes of the cells of a type as runs of equal cells. Arrays of aggregates keep
+        // the runs of a single element and the number of elements
+        struct cell_layout {
+            // Pairs of the cell size and the number of cells
+            std::vector<std::pair<unsigned, unsigned>> runs;
+            unsigned repeat = 1;
+
+            // Number of cells
+            size_t size() const {
+                return cells * repeat;
+            }
+
+            void append(unsigned cell_size, unsigned amount) {
+                if (amount == 0) {
+                    return;
+                }
+                ASSERT(repeat == 1);
+                if (!runs.empty() && runs.back().first == cell_size) {
+                    runs.back().second += amount;
+                } else {
+                    runs.emplace_back(cell_size, amount);
+                }
+                cells += amount;
+            }
+
+            void append(const cell_layout &other) {
+                if (other.runs.size() == 1) {
+                    append(other.runs[0].first, other.runs[0].second * other.repeat);
+                    return;
+                }
+                for (unsigned i = 0; i < other.repeat; ++i) {
+                    for (const auto &[cell_size, amount] : other.runs) {
+                        append(cell_size, amount);
+                    }
+                }
+            }
+
+        private:
+            size_t cells = 0;
+        };
+
+        // Reference to a cell of cell_columns
+        template<typename VarType>
+        struct cell_ref {
+            VarType &v;
+            ptr_type &offset;
+            int8_t &size;
+
+            cell_ref &operator=(const cell<VarType> &other) {
+                v = other.v;
+                offset = other.offset;
+                size = other.size;
+                return *this;
+            }
+        };
+
+        // Cells are stored column-wise, so that offset searches only touch the offsets
+        template<typename VarType>
+        struct cell_columns {
+            std::vector<ptr_type> offsets;
+            std::vector<int8_t> sizes;
+            std::vector<VarType> values;
+
+            size_t size() const {
+                return offsets.size();
+            }
+
+            void resize(size_t new_size) {
+                offsets.resize(new_size);
+                sizes.resize(new_size);
+                values.resize(new_size);
+            }
+
+            void push_back(const cell<VarType> &new_cell) {
+                offsets.push_back(new_cell.offset);
+                sizes.push_back(new_cell.size);
+                values.push_back(new_cell.v);
+            }
+
+            cell_ref<VarType> operator[](size_t idx) {
+                return {values[idx], offsets[idx], sizes[idx]};
+            }
+        };
+
         template<typename VarType>
-        struct program_memory : public std::vector<cell<VarType>> {
+        struct program_memory {
         public:
-            program_memory(size_t stack_size) : stack_size(stack_size), heap_top(stack_size) {
-                this->push_back({VarType(), 0, 0});
-                this->resize(heap_top);
-                this->push_back({VarType(), stack_size + 1, 0});
+            // The stack cells are created when they are pushed, only the address range is reserved
+            program_memory(size_t stack_size) :
+                stack_size(stack_size), heap_top(stack_size), heap_end(stack_size + 1),
+                heap_sentinel({VarType(), ptr_type(stack_size + 1), 0}) {
+                stack_cells.push_back({VarType(), 0, 0});
+                push_frame();
+            }
+
+            // Forget all the allocations. Like pop_frame, only stack_top is reset: the stack cells
+            // stay allocated and are reused by the next evaluation
+            void reset() {
+                stack_cells[0] = {VarType(), 0, 0};
+                heap_sentinel = {VarType(), ptr_type(stack_size + 1), 0};
+                heap_cells.resize(0);
+                heap_end = heap_top + 1;
+                allocations.clear();
+                free_blocks.clear();
+                for (auto &size_class : free_lists) {
+                    size_class.clear();
+                }
+                stack_top = 1;
+                frames = std::stack<ptr_type>();
                 push_frame();
             }
+
+            // Read-only view of a cell, the values are changed by store, copy, move and fill
+            cell<VarType> operator[](ptr_type ptr) const {
+                if (ptr < heap_top) {
+                    ASSERT_MSG(ptr < stack_cells.size(), "Access to the unallocated stack memory");
+                    return {stack_cells.values[ptr], stack_cells.offsets[ptr], stack_cells.sizes[ptr]};
+                }
+                if (ptr == heap_top) {
+                    return heap_sentinel;
+                }
+                ASSERT_MSG(ptr < heap_end, "Access to the unallocated heap memory");
+                size_t idx = heap_index(ptr);
+                if (heap_cells.offsets[idx] == 0) {
+                    return {VarType(), ptr, 1};
+                }
+                return {heap_cells.values[idx], heap_cells.offsets[idx], heap_cells.sizes[idx]};
+            }
+
             void stack_push(size_t offset, int8_t size) {
-                cell<VarType> &new_cell = this->operator[](stack_top++);
-                new_cell.offset = offset;
-                new_cell.size = size;
+                ASSERT_MSG(stack_top < heap_top, "Stack overflow");
+                if (stack_top == stack_cells.size()) {
+                    stack_cells.push_back({VarType(), ptr_type(offset), size});
+                    ++stack_top;
+                    return;
+                }
+                stack_cells.offsets[stack_top] = offset;
+                stack_cells.sizes[stack_top] = size;
+                ++stack_top;
             }
 
             void push_frame() {
@@ -69,9 +200,23 @@ namespace nil {
                 frames.pop();
             }
 
+            ptr_type add_cells(const cell_layout &layout) {
+                ptr_type res = stack_top;
+                unsigned next_offset = stack_cells.offsets[stack_top - 1] + stack_cells.sizes[stack_top - 1];
+                for (unsigned i = 0; i < layout.repeat; ++i) {
+                    for (const auto &[cell_size, amount] : layout.runs) {
+                        for (unsigned j = 0; j < amount; ++j) {
+                            stack_push(next_offset, cell_size);
+                            next_offset += cell_size;
+                        }
+                    }
+                }
+                return res;
+            }
+
             ptr_type add_cells(const std::vector<unsigned> &layout) {
                 ptr_type res = stack_top;
-                unsigned next_offset = this->at(stack_top - 1).offset + this->at(stack_top - 1).size;
+                unsigned next_offset = stack_cells.offsets[stack_top - 1] + stack_cells.sizes[stack_top - 1];
                 for (unsigned cell_size : layout) {
                     stack_push(next_offset, cell_size);
                     next_offset += cell_size;
@@ -79,48 +224,387 @@ namespace nil {
                 return res;
             }
 
+            // A fresh heap block is one untyped extent: its cells have no offset yet and a cell is split off
+            // when a load or a store touches its address
             ptr_type malloc(size_t num_bytes) {
-                auto offset = this->back().offset + this->back().size;
-                ptr_type res = this->size();
-                for (size_t i = 0; i < num_bytes; ++i) {
-                    this->push_back(cell<VarType>{VarType(), offset++, 1});
+                // Every allocation gets a distinct address, even the empty one
+                num_bytes = std::max<size_t>(num_bytes, 1);
+                ptr_type res = take_free_block(num_bytes);
+                if (res == 0) {
+                    res = heap_end;
+                    heap_end += num_bytes;
+                    if (heap_cells.size() < heap_index(heap_end)) {
+                        heap_cells.resize(heap_index(heap_end));
+                    }
                 }
+                allocations[res] = num_bytes;
                 return res;
             }
 
+            void free(ptr_type ptr) {
+                if (ptr == 0) {
+                    return;
+                }
+                auto allocation = allocations.find(ptr);
+                ASSERT_MSG(allocation != allocations.end(), "Freeing a pointer which was not allocated");
+                size_t num_bytes = allocation->second;
+                allocations.erase(allocation);
+
+                // Drop the cells split off the block, so it can be reused with any layout
+                std::fill_n(heap_cells.offsets.begin() + heap_index(ptr), num_bytes, 0);
+                std::fill_n(heap_cells.values.begin() + heap_index(ptr), num_bytes, VarType());
+
+                // Coalesce with the adjacent free blocks
+                auto next = free_blocks.find(ptr + num_bytes);
+                if (next != free_blocks.end()) {
+                    num_bytes += next->second;
+                    remove_free_block(next);
+                }
+                auto prev = free_blocks.lower_bound(ptr);
+                if (prev != free_blocks.begin()) {
+                    --prev;
+                    if (prev->first + prev->second == ptr) {
+                        ptr = prev->first;
+                        num_bytes += prev->second;
+                        remove_free_block(prev);
+                    }
+                }
+
+                if (ptr + num_bytes == heap_end) {
+                    // The block is on top of the heap, give the addresses back
+                    heap_end = ptr;
+                } else {
+                    add_free_block(ptr, num_bytes);
+                }
+            }
+
             void store(ptr_type ptr, VarType value) {
-                (*this)[ptr].v = value;
+                cell_ref<VarType> dst = cell_at(ptr);
+                ASSERT_MSG(ptr <= heap_top || dst.size != 0, "Store into the middle of a cell");
+                dst.v = value;
+            }
+
+            // Stores a value of size bytes and returns the next cell. A cell of another size gets
+            // the layout of the value, see copy
+            ptr_type store_typed(ptr_type ptr, VarType value, int8_t size) {
+                if ((*this)[ptr].size != size) {
+                    merge_cells(ptr, size);
+                }
+                store(ptr, value);
+                return next_cell(ptr);
             }
-            VarType load(ptr_type ptr) {
+
+            VarType load(ptr_type ptr) const {
                 return (*this)[ptr].v;
             }
 
-            size_t ptrtoint(ptr_type ptr) {
+            // Stores consecutive values starting from ptr, cells on the stack are written in one go
+            template<typename Iterator>
+            void store(ptr_type ptr, Iterator first, Iterator last) {
+                size_t amount = std::distance(first, last);
+                if (ptr + amount <= std::min<size_t>(heap_top, stack_cells.size())) {
+                    std::copy(first, last, stack_cells.values.begin() + ptr);
+                    return;
+                }
+                for (; first != last; ++first) {
+                    store(ptr++, *first);
+                }
+            }
+
+            // Copies the values of the cells covering num_bytes. Stack ranges with the same layout are copied
+            // column-wise. Otherwise the destination takes the layout of the source: heap cells are split again,
+            // byte cells on the stack are merged
+            void copy(ptr_type dst, ptr_type src, size_t num_bytes) {
+                if (copy_stack_range(dst, src, num_bytes)) {
+                    return;
+                }
+                size_t copied = 0;
+                while (copied < num_bytes) {
+                    auto src_cell = (*this)[src];
+                    if (src_cell.size == 0) {
+                        src = next_cell(src);
+                        continue;
+                    }
+                    if (dst < heap_top && (*this)[dst].size == 0) {
+                        dst = next_cell(dst);
+                        continue;
+                    }
+                    if ((*this)[dst].size != src_cell.size) {
+                        merge_cells(dst, src_cell.size);
+                    }
+                    cell_at(dst).v = src_cell.v;
+                    copied += src_cell.size;
+                    src = next_cell(src);
+                    dst = next_cell(dst);
+                }
+            }
+
+            // Same as copy, but the ranges may overlap
+            void move(ptr_type dst, ptr_type src, size_t num_bytes) {
+                size_t src_offset = (*this)[src].offset;
+                size_t dst_offset = (*this)[dst].offset;
+                if (src_offset + num_bytes <= dst_offset || dst_offset + num_bytes <= src_offset) {
+                    copy(dst, src, num_bytes);
+                    return;
+                }
+                if (copy_stack_range(dst, src, num_bytes)) {
+                    return;
+                }
+                std::vector<std::pair<VarType, int8_t>> buffer;
+                for (size_t read = 0; read < num_bytes; src = next_cell(src)) {
+                    auto src_cell = (*this)[src];
+                    if (src_cell.size != 0) {
+                        buffer.emplace_back(src_cell.v, src_cell.size);
+                        read += src_cell.size;
+                    }
+                }
+                for (const auto &[value, size] : buffer) {
+                    while (dst < heap_top && (*this)[dst].size == 0) {
+                        dst = next_cell(dst);
+                    }
+                    if ((*this)[dst].size != size) {
+                        merge_cells(dst, size);
+                    }
+                    cell_at(dst).v = value;
+                    dst = next_cell(dst);
+                }
+            }
+
+            // Sets every cell covering num_bytes to value_for_size(cell size), the layout is kept
+            template<typename ValueGenerator>
+            void fill(ptr_type dst, size_t num_bytes, ValueGenerator value_for_size) {
+                size_t filled = 0;
+                while (filled < num_bytes) {
+                    cell_ref<VarType> dst_cell = cell_at(dst);
+                    dst_cell.v = value_for_size(dst_cell.size);
+                    filled += dst_cell.size;
+                    dst = next_cell(dst);
+                }
+            }
+
+            size_t ptrtoint(ptr_type ptr) const {
                 return (*this)[ptr].offset;
             }
 
+            // Finds the cell starting at the offset. The heap cells are numbered by their offsets.
+            // The hint is the base cell plus the index times the number of cells per element, so it tells
+            // the heap from the stack: stack offsets are in bytes and can exceed the number of stack cells.
+            // On the stack the hint is also tried as the result first
+            ptr_type offset_to_ptr(size_t offset, ptr_type hint) {
+                if (hint > heap_top) {
+                    ASSERT_MSG(offset < heap_end && (*this)[offset].offset == offset, "Offset does not match memory");
+                    return offset;
+                }
+                if (hint > 0 && hint < stack_top && stack_cells.offsets[hint] == offset && stack_cells.sizes[hint] != 0) {
+                    return hint;
+                }
+                ptr_type res = inttoptr(offset);
+                ASSERT_MSG(res != 0 && (*this)[res].offset == offset, "Offset does not match memory");
+                return res;
+            }
+
             ptr_type inttoptr(size_t offset) {
-                // Find the corresponding cell using binary search
-                auto left = this->begin();
-                auto right = this->end();
                 if (offset < stack_size) {
-                    right = left + stack_top;
-                } else {
-                    left = left + stack_size;
+                    // Find the corresponding cell using binary search
+                    auto left = stack_cells.offsets.begin();
+                    auto right = left + stack_top;
+                    auto res = std::lower_bound(left, right, offset);
+                    if (res == right) {
+                        return 0;
+                    }
+                    return res - left;
                 }
-                auto res = std::lower_bound(
-                    left, right, offset, [](const cell<VarType> &cell, size_t offset) { return cell.offset < offset; });
-                if (res == right) {
+                // Heap cells are numbered by their offsets, skip the bytes merged into the previous cell
+                size_t res = std::max<size_t>(offset, heap_top + 1);
+                if (res >= heap_end) {
                     return 0;
                 }
-                return res - this->begin();
+                ptr_type head = heap_cells.offsets[heap_index(res)];
+                if (head != 0 && head != res) {
+                    res = head + heap_cells.sizes[heap_index(head)];
+                }
+                if (res >= heap_end) {
+                    return 0;
+                }
+                return res;
+            }
+
+            // A cell is followed by the cells merged into it, they are left in place with
+            // the offset of the merged cell and no size
+            ptr_type next_cell(ptr_type ptr) const {
+                if (ptr < heap_top) {
+                    ptr_type res = ptr + 1;
+                    if (ptr < stack_top && stack_cells.sizes[ptr] > 1) {
+                        while (res < stack_top && stack_cells.sizes[res] == 0 &&
+                               stack_cells.offsets[res] == stack_cells.offsets[ptr]) {
+                            ++res;
+                        }
+                    }
+                    return res;
+                }
+                if (ptr == heap_top) {
+                    return ptr + 1;
+                }
+                return ptr + std::max<int8_t>((*this)[ptr].size, 1);
             }
 
         private:
+            size_t heap_index(ptr_type ptr) const {
+                return ptr - heap_top - 1;
+            }
+
+            // The untouched bytes of a heap block get a one byte cell when they are written
+            cell_ref<VarType> cell_at(ptr_type ptr) {
+                if (ptr < heap_top) {
+                    ASSERT_MSG(ptr < stack_cells.size(), "Access to the unallocated stack memory");
+                    return stack_cells[ptr];
+                }
+                if (ptr == heap_top) {
+                    return {heap_sentinel.v, heap_sentinel.offset, heap_sentinel.size};
+                }
+                ASSERT_MSG(ptr < heap_end, "Access to the unallocated heap memory");
+                size_t idx = heap_index(ptr);
+                if (heap_cells.offsets[idx] == 0) {
+                    heap_cells.offsets[idx] = ptr;
+                    heap_cells.sizes[idx] = 1;
+                }
+                return heap_cells[idx];
+            }
+
+            // Copies the values of the stack cells covering num_bytes in one go if both ranges have the same layout
+            bool copy_stack_range(ptr_type dst, ptr_type src, size_t num_bytes) {
+                if (src >= stack_top || dst >= stack_top) {
+                    return false;
+                }
+                size_t amount = 0;
+                size_t bytes = 0;
+                while (bytes < num_bytes) {
+                    if (src + amount >= stack_top) {
+                        return false;
+                    }
+                    bytes += stack_cells.sizes[src + amount];
+                    ++amount;
+                }
+                if (bytes != num_bytes || dst + amount > stack_top) {
+                    return false;
+                }
+                auto sizes = stack_cells.sizes.begin();
+                if (!std::equal(sizes + src, sizes + src + amount, sizes + dst)) {
+                    return false;
+                }
+                auto values = stack_cells.values.begin();
+                if (dst <= src) {
+                    std::copy(values + src, values + src + amount, values + dst);
+                } else {
+                    std::copy_backward(values + src, values + src + amount, values + dst + amount);
+                }
+                return true;
+            }
+
+            // Gives the destination of a copy a cell of the source size at ptr
+            void merge_cells(ptr_type ptr, int8_t size) {
+                if (ptr < heap_top) {
+                    merge_stack_cells(ptr, size);
+                    return;
+                }
+                ASSERT_MSG(ptr > heap_top, "Copy to the end of the stack");
+                ASSERT_MSG(ptr + size <= heap_end, "Access to the unallocated heap memory");
+                ASSERT_MSG((*this)[ptr].size != 0, "Copy into the middle of a cell");
+                // The cells overlapped by the new one are dropped, the bytes they covered past it become untouched
+                ptr_type end = ptr + size;
+                for (ptr_type i = end; i < heap_end && heap_cells.sizes[heap_index(i)] == 0; ++i) {
+                    ptr_type head = heap_cells.offsets[heap_index(i)];
+                    if (head < ptr || head >= end) {
+                        break;
+                    }
+                    heap_cells.offsets[heap_index(i)] = 0;
+                }
+                heap_cells.offsets[heap_index(ptr)] = ptr;
+                heap_cells.sizes[heap_index(ptr)] = size;
+                for (ptr_type i = ptr + 1; i < end; ++i) {
+                    heap_cells.offsets[heap_index(i)] = ptr;
+                    heap_cells.sizes[heap_index(i)] = 0;
+                }
+            }
+
+            // The stack cells have fixed numbers, only a range of byte cells (a char array) can take
+            // another layout. Bytes merged before are restored, a merged cell ending past the range is split
+            void merge_stack_cells(ptr_type ptr, int8_t size) {
+                ptr_type base_offset = stack_cells.offsets[ptr];
+                ptr_type end = ptr;
+                while (end - ptr < ptr_type(size)) {
+                    ASSERT_MSG(end < stack_top && stack_cells.offsets[end] == base_offset + end - ptr &&
+                                   stack_cells.sizes[end] > 0,
+                               "Copy between stack cells of different layouts");
+                    ptr_type next = next_cell(end);
+                    ASSERT_MSG(next - end == ptr_type(stack_cells.sizes[end]) || stack_cells.sizes[end] == 1,
+                               "Copy between stack cells of different layouts");
+                    end = next;
+                }
+                for (ptr_type i = ptr; i < end; ++i) {
+                    stack_cells.offsets[i] = base_offset + i - ptr;
+                    stack_cells.sizes[i] = 1;
+                }
+                stack_cells.sizes[ptr] = size;
+                for (ptr_type i = ptr + 1; i < ptr + size; ++i) {
+                    stack_cells.offsets[i] = base_offset;
+                    stack_cells.sizes[i] = 0;
+                }
+            }
+
+            static size_t size_class(size_t num_bytes) {
+                size_t res = 0;
+                while (num_bytes >>= 1) {
+                    ++res;
+                }
+                return res;
+            }
+
+            void add_free_block(ptr_type ptr, size_t num_bytes) {
+                free_blocks[ptr] = num_bytes;
+                free_lists[size_class(num_bytes)].insert(ptr);
+            }
+
+            void remove_free_block(typename std::map<ptr_type, size_t>::iterator block) {
+                free_lists[size_class(block->second)].erase(block->first);
+                free_blocks.erase(block);
+            }
+
+            // Returns 0 if there is no free block large enough
+            ptr_type take_free_block(size_t num_bytes) {
+                for (size_t i = size_class(num_bytes); i < free_lists.size(); ++i) {
+                    for (ptr_type candidate : free_lists[i]) {
+                        auto block = free_blocks.find(candidate);
+                        size_t block_size = block->second;
+                        if (block_size < num_bytes) {
+                            continue;
+                        }
+                        remove_free_block(block);
+                        if (block_size > num_bytes) {
+                            add_free_block(candidate + num_bytes, block_size - num_bytes);
+                        }
+                        return candidate;
+                    }
+                }
+                return 0;
+            }
+
             ptr_type stack_top = 1;
             size_t stack_size;
             size_t heap_top;
+            // The first address after the last heap allocation
+            size_t heap_end;
+            // Grows up to the highest stack_top, pop_frame keeps the cells
+            cell_columns<VarType> stack_cells;
+            cell<VarType> heap_sentinel;
+            // Cells of the heap numbered from heap_top + 1, the cells of an untouched byte have no offset
+            cell_columns<VarType> heap_cells;
             std::stack<ptr_type> frames;
+            // Live heap allocations and free heap blocks, both map the first cell to the number of cells
+            std::map<ptr_type, size_t> allocations;
+            std::map<ptr_type, size_t> free_blocks;
+            // Free blocks grouped by the power of two of their size
+            std::array<std::set<ptr_type>, 64> free_lists;
         };
 
     }    // namespace blueprint
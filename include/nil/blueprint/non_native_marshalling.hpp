@@ -138,6 +138,24 @@ namespace nil {
         }
 
 
+        // Same check as check_modulus_and_chop does, but without aborting
+        template<typename BlueprintFieldType>
+        bool fits_field_modulus(llvm::GaloisFieldKind arg_field_type,
+                                const typename BlueprintFieldType::extended_integral_type &glued_non_native) {
+            switch (arg_field_type) {
+                case llvm::GALOIS_FIELD_CURVE25519_BASE:
+                    return glued_non_native < nil::crypto3::algebra::curves::ed25519::base_field_type::modulus;
+                case llvm::GALOIS_FIELD_CURVE25519_SCALAR:
+                    return glued_non_native < nil::crypto3::algebra::curves::ed25519::scalar_field_type::modulus;
+                case llvm::GALOIS_FIELD_PALLAS_BASE:
+                    return glued_non_native < nil::crypto3::algebra::curves::pallas::base_field_type::modulus;
+                case llvm::GALOIS_FIELD_PALLAS_SCALAR:
+                    return glued_non_native < nil::crypto3::algebra::curves::pallas::scalar_field_type::modulus;
+                default:
+                    return false;
+            }
+        }
+
         template<typename BlueprintFieldType>
         std::vector<typename BlueprintFieldType::value_type> extended_integral_into_vector (llvm::GaloisFieldKind arg_field_type, typename BlueprintFieldType::extended_integral_type glued_non_native) {
             switch (arg_field_type) {
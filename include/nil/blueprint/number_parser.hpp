@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_NUMBER_PARSER_HPP
+#define CRYPTO3_ASSIGNER_NUMBER_PARSER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace nil {
+    namespace blueprint {
+        namespace detail {
+            inline int digit_value(char c, bool hex) {
+                if (c >= '0' && c <= '9') {
+                    return c - '0';
+                }
+                if (hex && c >= 'a' && c <= 'f') {
+                    return c - 'a' + 10;
+                }
+                if (hex && c >= 'A' && c <= 'F') {
+                    return c - 'A' + 10;
+                }
+                return -1;
+            }
+        }    // namespace detail
+
+        // Parses a non-negative decimal or 0x-prefixed hexadecimal number. The digits are accumulated
+        // in a machine word, 19 decimal or 16 hexadecimal digits at a time, and the big number is only
+        // updated once per word. On failure the error is set and false is returned
+        template<typename IntegralType>
+        bool parse_number(std::string_view text, IntegralType &number, std::string &error) {
+            bool hex = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+            if (hex) {
+                text.remove_prefix(2);
+            }
+            if (text.empty()) {
+                error = "empty number";
+                return false;
+            }
+
+            // Leading zeros do not count towards the length limit
+            std::size_t first_significant = text.find_first_not_of('0');
+            std::size_t significant_digits = first_significant == std::string_view::npos ? 0 : text.size() - first_significant;
+            constexpr std::size_t bits = std::numeric_limits<IntegralType>::digits;
+            // log10(2) is rounded down, so that 10^max_digits - 1 still fits
+            std::size_t max_digits = hex ? bits / 4 : bits * 30102 / 100000;
+            if (significant_digits > max_digits) {
+                error = "number " + std::string(text) + " is too large";
+                return false;
+            }
+
+            const std::size_t chunk_digits = hex ? 16 : 19;
+            number = 0;
+            std::size_t pos = 0;
+            while (pos < text.size()) {
+                std::size_t chunk_start = pos;
+                std::size_t chunk_end = std::min(text.size(), pos + chunk_digits);
+                std::uint64_t chunk = 0;
+                for (; pos < chunk_end; ++pos) {
+                    int digit = detail::digit_value(text[pos], hex);
+                    if (digit < 0) {
+                        error = "unexpected character '" + std::string(1, text[pos]) + "' in number " + std::string(text);
+                        return false;
+                    }
+                    chunk = hex ? (chunk << 4) | digit : chunk * 10 + digit;
+                }
+                if (hex) {
+                    number <<= 4 * (chunk_end - chunk_start);
+                    number += chunk;
+                } else {
+                    std::uint64_t scale = 1;
+                    for (std::size_t i = chunk_start; i < chunk_end; ++i) {
+                        scale *= 10;
+                    }
+                    number *= scale;
+                    number += chunk;
+                }
+            }
+            return true;
+        }
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_NUMBER_PARSER_HPP
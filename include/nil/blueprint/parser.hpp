@@ -26,6 +26,10 @@
 #ifndef CRYPTO3_BLUEPRINT_COMPONENT_INSTRUCTION_PARSER_HPP
 #define CRYPTO3_BLUEPRINT_COMPONENT_INSTRUCTION_PARSER_HPP
 
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <unordered_set>
 #include <variant>
 #include <stack>
 
@@ -47,9 +51,13 @@
 #include "llvm/IR/TypeFinder.h"
 #include "llvm/IR/TypedPointerType.h"
 #include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/Operator.h"
 
 #include <nil/blueprint/logger.hpp>
+#include <nil/blueprint/decoded_program.hpp>
+#include <nil/blueprint/generation_mode.hpp>
 #include <nil/blueprint/layout_resolver.hpp>
+#include <nil/blueprint/pre_optimization.hpp>
 #include <nil/blueprint/input_reader.hpp>
 #include <nil/blueprint/non_native_marshalling.hpp>
 #include <nil/blueprint/stack.hpp>
@@ -112,21 +120,41 @@ namespace nil {
             std::vector<circuit_proxy<ArithmetizationType>> circuits;
             std::vector<assignment_proxy<ArithmetizationType>> assignments;
 
-        private:
-
-            std::string extract_metadata(const llvm::Instruction *inst) {
-                const llvm::MDNode* metaDataNode = inst->getMetadata("zk_multi_prover");
-                if (metaDataNode) {
-                    const llvm::MDString *MDS = llvm::dyn_cast<llvm::MDString>(metaDataNode->getOperand(0));
-                    return MDS->getString().str();
+            // Reuse the circuit of a previous full run, the next evaluation only fills the assignment table
+            void set_circuit_template(const circuit_template<ArithmetizationType> &cached) {
+                cached_circuit = cached;
+                if (!evaluated) {
+                    bp_ptr = cached.bp;
+                    circuits.clear();
+                    circuits.emplace_back(bp_ptr, currProverIdx);
                 }
-                return "";
             }
 
-            template<typename map_type>
-            void handle_scalar_cmp(const llvm::ICmpInst *inst, map_type &variables, bool next_prover) {
-                const var &lhs = variables[inst->getOperand(0)];
-                const var &rhs = variables[inst->getOperand(1)];
+            // Generate witnesses of independent components on several threads, 0 or 1 keeps the sequential generation
+            void set_assignment_threads(std::size_t threads_amount) {
+                assignment_threads = threads_amount;
+            }
+
+            // Run the safe subset of LLVM optimizations on the modules read by parseIRFile, see run_pre_optimization
+            void set_pre_optimization(bool enabled) {
+                pre_optimization = enabled;
+            }
+
+            circuit_template<ArithmetizationType> get_circuit_template() const {
+                return {bp_ptr, assignment_ptr, circuit_fingerprint, assignment_ptr->allocated_rows()};
+            }
+
+            // Why the last evaluation rejected its input, empty if the input was read
+            const std::string &get_input_error() const {
+                return input_error;
+            }
+
+        private:
+
+            void handle_scalar_cmp(const decoded_instruction &op, value_storage<var> &variables, bool next_prover) {
+                auto inst = llvm::cast<const llvm::ICmpInst>(op.inst);
+                const var &lhs = variables.at_slot(op.operands[0]);
+                const var &rhs = variables.at_slot(op.operands[1]);
 
                 llvm::CmpInst::Predicate p = inst->getPredicate();
 
@@ -135,11 +163,11 @@ namespace nil {
                     const auto start_row = assignments[currProverIdx].allocated_rows();
                     const auto v = handle_comparison_component<BlueprintFieldType, ArithmetizationParams>(
                         p, lhs, rhs, bitness,
-                        circuits[currProverIdx], assignments[currProverIdx], start_row, public_input_idx);
+                        circuits[currProverIdx], assignments[currProverIdx], generation, start_row, public_input_idx);
                     if (next_prover) {
-                        variables[inst] = save_shared_var(assignments[currProverIdx], v);
+                        variables.at_slot(op.result) = save_shared_var(assignments[currProverIdx], v);
                     } else {
-                        variables[inst] = v;
+                        variables.at_slot(op.result) = v;
                     }
                 } else {
                     bool res;
@@ -169,13 +197,14 @@ namespace nil {
                         UNREACHABLE("Unsupported icmp predicate");
                         break;
                     }
-                    variables[inst] = put_into_assignment(res);
+                    variables.at_slot(op.result) = put_host_value(res);
                 }
             }
 
-            void handle_vector_cmp(const llvm::ICmpInst *inst, stack_frame<var> &frame, bool next_prover) {
-                const std::vector<var> &lhs = frame.vectors[inst->getOperand(0)];
-                const std::vector<var> &rhs = frame.vectors[inst->getOperand(1)];
+            void handle_vector_cmp(const decoded_instruction &op, stack_frame<var> &frame, bool next_prover) {
+                auto inst = llvm::cast<const llvm::ICmpInst>(op.inst);
+                const std::vector<var> &lhs = frame.vectors.at_slot(op.operands[0]);
+                const std::vector<var> &rhs = frame.vectors.at_slot(op.operands[1]);
                 ASSERT(lhs.size() == rhs.size());
                 std::vector<var> res;
 
@@ -191,23 +220,24 @@ namespace nil {
                     const auto start_row = assignments[currProverIdx].allocated_rows();
                     auto v = handle_comparison_component<BlueprintFieldType, ArithmetizationParams>(
                         inst->getPredicate(), lhs[i], rhs[i], bitness,
-                        circuits[currProverIdx], assignments[currProverIdx], start_row, public_input_idx);
+                        circuits[currProverIdx], assignments[currProverIdx], generation, start_row, public_input_idx);
 
                     res.emplace_back(v);
                 }
                 if (next_prover) {
-                    frame.vectors[inst] = save_shared_var(assignments[currProverIdx], res);
+                    frame.vectors.at_slot(op.result) = save_shared_var(assignments[currProverIdx], res);
                 } else {
-                    frame.vectors[inst] = res;
+                    frame.vectors.at_slot(op.result) = res;
                 }
             }
 
-            void handle_curve_cmp(const llvm::ICmpInst *inst, stack_frame<var> &frame, bool next_prover) {
+            void handle_curve_cmp(const decoded_instruction &op, stack_frame<var> &frame, bool next_prover) {
+                auto inst = llvm::cast<const llvm::ICmpInst>(op.inst);
                 ASSERT(llvm::cast<llvm::EllipticCurveType>(inst->getOperand(0)->getType())->getCurveKind() ==
                    llvm::cast<llvm::EllipticCurveType>(inst->getOperand(1)->getType())->getCurveKind());
 
-                const std::vector<var> &lhs = frame.vectors[inst->getOperand(0)];
-                const std::vector<var> &rhs = frame.vectors[inst->getOperand(1)];
+                const std::vector<var> &lhs = frame.vectors.at_slot(op.operands[0]);
+                const std::vector<var> &rhs = frame.vectors.at_slot(op.operands[1]);
                 ASSERT(lhs.size() != 0 && lhs.size() == rhs.size());
 
                 ASSERT_MSG(inst->getPredicate() == llvm::CmpInst::ICMP_EQ, "only == comparison is implemented for curve elements");
@@ -217,7 +247,7 @@ namespace nil {
                 for (size_t i = 0; i < lhs.size(); ++i) {
                     auto v = handle_comparison_component<BlueprintFieldType, ArithmetizationParams>(
                         inst->getPredicate(), lhs[i], rhs[i], 0,
-                        circuits[currProverIdx], assignments[currProverIdx], assignments[currProverIdx].allocated_rows(), public_input_idx);
+                        circuits[currProverIdx], assignments[currProverIdx], generation, assignments[currProverIdx].allocated_rows(), public_input_idx);
                     res.emplace_back(v);
                 }
 
@@ -225,20 +255,21 @@ namespace nil {
 
                 for (size_t i = 1; i < lhs.size(); ++i) {
                     are_curves_equal = handle_logic_and<BlueprintFieldType, ArithmetizationParams>(
-                        are_curves_equal, res[i], circuits[currProverIdx], assignments[currProverIdx],
+                        are_curves_equal, res[i], circuits[currProverIdx], assignments[currProverIdx], generation,
                         assignments[currProverIdx].allocated_rows(), public_input_idx);
                 }
                 if (next_prover) {
-                    frame.scalars[inst] = save_shared_var(assignments[currProverIdx], are_curves_equal);
+                    frame.scalars.at_slot(op.result) = save_shared_var(assignments[currProverIdx], are_curves_equal);
                 } else {
-                    frame.scalars[inst] = are_curves_equal;
+                    frame.scalars.at_slot(op.result) = are_curves_equal;
                 }
             }
 
-            void handle_ptr_cmp(const llvm::ICmpInst *inst, stack_frame<var> &frame) {
-                ptr_type lhs = resolve_number<ptr_type>(frame, inst->getOperand(0));
-                ASSERT(frame.scalars.find(inst->getOperand(1)) != frame.scalars.end());
-                ptr_type rhs = resolve_number<ptr_type>(frame, inst->getOperand(1));
+            void handle_ptr_cmp(const decoded_instruction &op, stack_frame<var> &frame) {
+                auto inst = llvm::cast<const llvm::ICmpInst>(op.inst);
+                ptr_type lhs = resolve_number<ptr_type>(frame, op.operands[0]);
+                ASSERT(frame.scalars.contains_slot(op.operands[1]));
+                ptr_type rhs = resolve_number<ptr_type>(frame, op.operands[1]);
                 bool res = false;
                 switch (inst->getPredicate()) {
                     case llvm::CmpInst::ICMP_EQ:
@@ -251,17 +282,21 @@ namespace nil {
                         UNREACHABLE("Unsupported predicate");
                         break;
                 }
-                frame.scalars[inst] = put_into_assignment(res);
+                frame.scalars.at_slot(op.result) = put_host_value(res);
             }
 
             template <typename NumberType>
-            NumberType resolve_number(stack_frame<var> &frame, const llvm::Value *value) {
-                var scalar = frame.scalars[value];
+            NumberType resolve_number(const stack_frame<var> &frame, std::uint32_t slot) {
+                var scalar = frame.scalars.at_slot(slot);
                 return resolve_number<NumberType>(scalar);
             }
 
             template <typename NumberType>
             NumberType resolve_number(var scalar) {
+                if (const shadow_entry *native = find_shadow(scalar)) {
+                    ASSERT_MSG(native->value < std::uint64_t(std::numeric_limits<NumberType>::max()), "");
+                    return static_cast<NumberType>(native->value);
+                }
                 auto scalar_value = var_value(assignments[currProverIdx], scalar);
                 static constexpr auto limit_value = typename BlueprintFieldType::integral_type(std::numeric_limits<NumberType>::max());
                 auto integral_value = static_cast<typename BlueprintFieldType::integral_type>(scalar_value.data);
@@ -314,7 +349,7 @@ namespace nil {
                     if (!type->isAggregateType() && !type->isVectorTy()) {
                         std::vector<typename BlueprintFieldType::value_type> marshalled_field_val = marshal_field_val<BlueprintFieldType>(constant);
                         for (int i = 0; i < marshalled_field_val.size(); i++) {
-                            auto variable = put_into_assignment(marshalled_field_val[i]);
+                            auto variable = put_constant_value(marshalled_field_val[i]);
                             stack_memory.store(ptr++, variable);
                         }
                         continue;
@@ -337,43 +372,37 @@ namespace nil {
                 return res;
             }
 
-            void memcpy(ptr_type dst, ptr_type src, unsigned width) {
-                unsigned copied = 0;
-                while (copied < width) {
-                    ASSERT(stack_memory[dst].size == stack_memory[src].size);
-                    copied += stack_memory[dst].size;
-                    stack_memory[dst++].v = stack_memory[src++].v;
-                }
-            }
-
-            bool handle_intrinsic(const llvm::CallInst *inst, llvm::Intrinsic::ID id, stack_frame<var> &frame, uint32_t start_row, bool next_prover) {
+            bool handle_intrinsic(const decoded_instruction &op, stack_frame<var> &frame, uint32_t start_row, bool next_prover) {
+                auto inst = llvm::cast<llvm::CallInst>(op.inst);
+                llvm::Intrinsic::ID id = op.intrinsic_id;
                 // Passing constants to component directly is only supported for bit decomposition
                 if (
                     id != llvm::Intrinsic::assigner_bit_decomposition &&
                     id != llvm::Intrinsic::assigner_bit_composition
                     ) {
                     for (int i = 0; i < inst->getNumOperands(); ++i) {
-                        llvm::Value *op = inst->getOperand(i);
-                        if (llvm::isa<llvm::Constant>(op)) {
-                            put_constant(llvm::cast<llvm::Constant>(op), frame);
+                        llvm::Value *operand = inst->getOperand(i);
+                        if (llvm::isa<llvm::Constant>(operand) && !frame.scalars.contains_slot(op.operands[i])) {
+                            put_constant(llvm::cast<llvm::Constant>(operand), frame);
                         }
                     }
                 }
 
                 switch (id) {
                     case llvm::Intrinsic::assigner_malloc: {
-                        size_t bytes = resolve_number<size_t>(frame, inst->getOperand(0));
-                        frame.scalars[inst] = put_into_assignment(stack_memory.malloc(bytes));
+                        size_t bytes = resolve_number<size_t>(frame, op.operands[0]);
+                        frame.scalars.at_slot(op.result) = put_host_value(stack_memory.malloc(bytes));
                         return true;
                     }
                     case llvm::Intrinsic::assigner_free: {
-                        // TODO(maksenov): implement allocator
+                        ptr_type ptr = resolve_number<ptr_type>(frame, op.operands[0]);
+                        stack_memory.free(ptr);
                         return true;
                     }
                     case llvm::Intrinsic::assigner_poseidon: {
                         using component_type = components::poseidon<ArithmetizationType, BlueprintFieldType>;
 
-                        auto &input_block = frame.vectors[inst->getOperand(0)];
+                        auto &input_block = frame.vectors.at_slot(op.operands[0]);
                         std::array<var, component_type::state_size> input_state_var;
                         std::copy(input_block.begin(), input_block.end(), input_state_var.begin());
 
@@ -382,52 +411,77 @@ namespace nil {
                         component_type component_instance({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14}, {},
                                                             {});
 
-                        components::generate_circuit(component_instance, circuits[currProverIdx], assignments[currProverIdx], instance_input, start_row);
+                        detail::generate_circuit(component_instance, circuits[currProverIdx], assignments[currProverIdx], generation, instance_input, start_row);
 
                         typename component_type::result_type component_result =
-                            components::generate_assignments(component_instance, assignments[currProverIdx], instance_input, start_row);
+                            detail::generate_assignments(component_instance, assignments[currProverIdx], generation, instance_input, start_row);
 
                         std::vector<var> output(component_result.output_state.begin(),
                                                 component_result.output_state.end());
                         if (next_prover) {
-                            frame.vectors[inst] = save_shared_var(assignments[currProverIdx], output);
+                            frame.vectors.at_slot(op.result) = save_shared_var(assignments[currProverIdx], output);
                         } else {
-                            frame.vectors[inst] = output;
+                            frame.vectors.at_slot(op.result) = output;
                         }
                         return true;
                     }
                     case llvm::Intrinsic::assigner_sha2_256: {
-                        handle_sha2_256_component<BlueprintFieldType, ArithmetizationParams>(inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
+                        handle_sha2_256_component<BlueprintFieldType, ArithmetizationParams>(op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
                         return true;
                     }
                     case llvm::Intrinsic::assigner_sha2_512: {
-                        handle_sha2_512_component<BlueprintFieldType, ArithmetizationParams>(inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
+                        handle_sha2_512_component<BlueprintFieldType, ArithmetizationParams>(op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
                         return true;
                     }
                     case llvm::Intrinsic::assigner_bit_decomposition: {
                         ASSERT(llvm::isa<llvm::Constant>(inst->getOperand(1)));
                         ASSERT(llvm::isa<llvm::Constant>(inst->getOperand(3)));
-                        handle_integer_bit_decomposition_component<BlueprintFieldType, ArithmetizationParams>(inst, frame, stack_memory, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
+                        handle_integer_bit_decomposition_component<BlueprintFieldType, ArithmetizationParams>(op, frame, stack_memory, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
                         return true;
                     }
                     case llvm::Intrinsic::assigner_bit_composition: {
                         ASSERT(llvm::isa<llvm::Constant>(inst->getOperand(1)));
                         ASSERT(llvm::isa<llvm::Constant>(inst->getOperand(2)));
-                        handle_integer_bit_composition_component<BlueprintFieldType, ArithmetizationParams>(inst, frame, stack_memory, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
+                        handle_integer_bit_composition_component<BlueprintFieldType, ArithmetizationParams>(op, frame, stack_memory, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
                         return true;
                     }
                     case llvm::Intrinsic::assigner_print_native_pallas_field: {
                         llvm::Value *input = inst->getOperand(0);
                         ASSERT(field_arg_num<BlueprintFieldType>(input->getType()) == 1);
-                        std::cout << var_value(assignments[currProverIdx], frame.scalars[input]).data << std::endl;
+                        std::cout << var_value(assignments[currProverIdx], frame.scalars.at_slot(op.operands[0])).data << std::endl;
                         return true;
                     }
                     case llvm::Intrinsic::memcpy: {
-                        llvm::Value *src_val = inst->getOperand(1);
-                        ptr_type dst = resolve_number<ptr_type>(frame, inst->getOperand(0));
-                        ptr_type src = resolve_number<ptr_type>(frame, src_val);
-                        unsigned width = resolve_number<unsigned>(frame, inst->getOperand(2));
-                        memcpy(dst, src, width);
+                        ptr_type dst = resolve_number<ptr_type>(frame, op.operands[0]);
+                        ptr_type src = resolve_number<ptr_type>(frame, op.operands[1]);
+                        unsigned width = resolve_number<unsigned>(frame, op.operands[2]);
+                        stack_memory.copy(dst, src, width);
+                        return true;
+                    }
+                    case llvm::Intrinsic::memmove: {
+                        ptr_type dst = resolve_number<ptr_type>(frame, op.operands[0]);
+                        ptr_type src = resolve_number<ptr_type>(frame, op.operands[1]);
+                        unsigned width = resolve_number<unsigned>(frame, op.operands[2]);
+                        stack_memory.move(dst, src, width);
+                        return true;
+                    }
+                    case llvm::Intrinsic::memset: {
+                        ptr_type dst = resolve_number<ptr_type>(frame, op.operands[0]);
+                        unsigned byte = resolve_number<unsigned>(frame, op.operands[1]);
+                        unsigned width = resolve_number<unsigned>(frame, op.operands[2]);
+                        stack_memory.fill(dst, width, [this, byte](int8_t cell_size) {
+                            if (byte == 0) {
+                                return zero_var;
+                            }
+                            // Every byte of the cell gets the value. Wider cells hold field elements, the bytes
+                            // are only replicated up to the largest integer so that the value is not reduced modulo p
+                            constexpr int8_t max_integer_bytes = 128 / 8;
+                            typename BlueprintFieldType::integral_type value = 0;
+                            for (int8_t i = 0; i < std::min(cell_size, max_integer_bytes); ++i) {
+                                value = (value << 8) + byte;
+                            }
+                            return put_constant_value(typename BlueprintFieldType::value_type(value));
+                        });
                         return true;
                     }
                     case llvm::Intrinsic::assigner_zkml_convolution: {
@@ -447,8 +501,8 @@ namespace nil {
                         return false;
                     }
                     case llvm::Intrinsic::expect: {
-                        var x = frame.scalars[inst->getOperand(0)];
-                        frame.scalars[inst] = x;
+                        var x = frame.scalars.at_slot(op.operands[0]);
+                        frame.scalars.at_slot(op.result) = x;
                         return true;
                     }
                     case llvm::Intrinsic::lifetime_start:
@@ -456,20 +510,22 @@ namespace nil {
                         // Nothing to do
                         return true;
                     case llvm::Intrinsic::assigner_curve_init: {
-                        handle_curve_init<var, BlueprintFieldType>(inst, frame);
+                        handle_curve_init<var, BlueprintFieldType>(op, frame);
                         return true;
                     }
 
                     case llvm::Intrinsic::assigner_exit_check: {
-                        const var &logical_statement = frame.scalars[inst->getOperand(0)];
+                        const var &logical_statement = frame.scalars.at_slot(op.operands[0]);
 
                         std::size_t bitness = inst->getOperand(0)->getType()->getPrimitiveSizeInBits();
 
                         var comparison_result = handle_comparison_component<BlueprintFieldType, ArithmetizationParams>(
                             llvm::CmpInst::ICMP_EQ, logical_statement, zero_var, bitness,
-                            circuits[currProverIdx], assignments[currProverIdx], assignments[currProverIdx].allocated_rows(), public_input_idx);
+                            circuits[currProverIdx], assignments[currProverIdx], generation, assignments[currProverIdx].allocated_rows(), public_input_idx);
 
-                        circuits[currProverIdx].add_copy_constraint({comparison_result, zero_var});
+                        if (generation.get_mode() == generation_mode::CIRCUIT_AND_ASSIGNMENTS) {
+                            circuits[currProverIdx].add_copy_constraint({comparison_result, zero_var});
+                        }
 
                         if (next_prover) {
                             save_shared_var(assignments[currProverIdx], comparison_result);
@@ -483,106 +539,76 @@ namespace nil {
                 return false;
             }
 
-            void handle_store(ptr_type ptr, const llvm::Value *val, stack_frame<var> &frame) {
-                auto store_scalar = [this](ptr_type ptr, var v, size_t type_size) ->ptr_type {
-                    auto &cell = stack_memory[ptr];
-                    size_t cur_offset = cell.offset;
-                    size_t cell_size = cell.size;
-                    if (cell_size != type_size) {
-                        ASSERT_MSG(cell_size == 1, "Unequal stores are only supported for malloc case");
-                        cell.size = type_size;
-                        cell.v = v;
-
-                        for (int i = 1; i < type_size; ++i) {
-                            auto &idle_cell = stack_memory[ptr + i];
-                            ASSERT(idle_cell.offset == ++cur_offset);
-                            idle_cell.offset = cell.offset;
-                            idle_cell.size = 0;
-                        }
-                        return ptr + cell_size;
-                    } else {
-                        cell.v = v;
-                        return ptr + 1;
-                    }
-                };
-
+            void handle_store(ptr_type ptr, const llvm::Value *val, std::uint32_t val_slot, stack_frame<var> &frame) {
                 if (auto vec_type = llvm::dyn_cast<llvm::FixedVectorType>(val->getType())) {
-                    std::vector<var> var_vec = frame.vectors[val];
+                    std::vector<var> var_vec = frame.vectors.at_slot(val_slot);
                     ASSERT_MSG(var_vec.size() == vec_type->getNumElements(), "Complex vectors are not supported");
                     unsigned elem_size = layout_resolver->get_type_size(vec_type->getElementType());
                     for (var v : var_vec) {
-                        ptr = store_scalar(ptr, v, elem_size);
+                        ptr = stack_memory.store_typed(ptr, v, elem_size);
                     }
                 } else {
                     unsigned type_size = layout_resolver->get_type_size(val->getType());
-                    store_scalar(ptr, frame.scalars[val], type_size);
+                    stack_memory.store_typed(ptr, frame.scalars.at_slot(val_slot), type_size);
                 }
             }
 
-            void handle_load(ptr_type ptr, const llvm::Value *dest, stack_frame<var> &frame) {
-                auto &cell = stack_memory[ptr];
+            void handle_load(ptr_type ptr, const llvm::Value *dest, std::uint32_t dest_slot, stack_frame<var> &frame) {
                 size_t num_cells = layout_resolver->get_type_layout<BlueprintFieldType>(dest->getType()).size();
                 if (num_cells == 1)
-                    frame.scalars[dest] = cell.v;
+                    frame.scalars.at_slot(dest_slot) = stack_memory.load(ptr);
                 else {
                     std::vector<var> res;
-                    for (size_t i = 0; i < num_cells; ++i) {
-                        res.push_back(stack_memory[ptr + i].v);
+                    for (size_t i = 0; i < num_cells; ++i, ptr = stack_memory.next_cell(ptr)) {
+                        res.push_back(stack_memory.load(ptr));
                     }
-                    frame.vectors[dest] = res;
+                    frame.vectors.at_slot(dest_slot) = res;
                 }
             }
 
-            ptr_type find_offset(ptr_type left_border, ptr_type right_border, size_t offset) {
-                for (ptr_type i = left_border; i <= right_border; ++i) {
-                    if (stack_memory[i].offset == offset) {
-                        return i;
-                    }
-                }
-                UNREACHABLE("Offset does not match memory");
-            }
-
             // Handle pointer adjustment specified by the first GEP index
-            ptr_type handle_initial_gep_adjustment(const llvm::GetElementPtrInst *gep, stack_frame<var> &frame,
+            ptr_type handle_initial_gep_adjustment(const decoded_instruction &op, stack_frame<var> &frame,
                                                    llvm::Type *gep_ty) {
-                typename BlueprintFieldType::value_type base_ptr =
-                    var_value(assignments[currProverIdx], frame.scalars[gep->getPointerOperand()]);
-                auto base_ptr_number = resolve_number<ptr_type>(frame.scalars[gep->getPointerOperand()]);
-                var gep_initial_idx = frame.scalars[gep->getOperand(1)];
-                size_t cells_for_type = layout_resolver->get_type_layout<BlueprintFieldType>(gep_ty).size();
-
-                auto naive_ptr_adjustment = cells_for_type * var_value(assignments[currProverIdx], gep_initial_idx);
-                auto adjusted_ptr = base_ptr + naive_ptr_adjustment;
-                if (adjusted_ptr == base_ptr) {
-                    // The index is zero, the ptr remains unchanged
-                    return base_ptr_number;
-                }
+                var base_ptr_var = frame.scalars.at_slot(op.operands[0]);
+                auto base_ptr_number = resolve_number<ptr_type>(base_ptr_var);
+                var gep_initial_idx = frame.scalars.at_slot(op.operands[1]);
                 int resolved_idx = 0;
-                // The index could be negative, so we need to take the difference with the modulus in this case
-                if (adjusted_ptr < base_ptr) {
-                    auto sub = BlueprintFieldType::modulus - static_cast<typename BlueprintFieldType::integral_type>(var_value(assignments[currProverIdx], gep_initial_idx).data);
-                    resolved_idx = static_cast<int>(sub) * -1;
-                } else {
+
+                if (const shadow_entry *native_idx = find_shadow(gep_initial_idx)) {
+                    if (native_idx->value == 0) {
+                        // The index is zero, the ptr remains unchanged
+                        return base_ptr_number;
+                    }
                     resolved_idx = resolve_number<int>(gep_initial_idx);
+                } else {
+                    typename BlueprintFieldType::value_type base_ptr = var_value(assignments[currProverIdx], base_ptr_var);
+                    size_t cells_for_type = layout_resolver->get_type_layout<BlueprintFieldType>(gep_ty).size();
+
+                    auto naive_ptr_adjustment = cells_for_type * var_value(assignments[currProverIdx], gep_initial_idx);
+                    auto adjusted_ptr = base_ptr + naive_ptr_adjustment;
+                    if (adjusted_ptr == base_ptr) {
+                        // The index is zero, the ptr remains unchanged
+                        return base_ptr_number;
+                    }
+                    // The index could be negative, so we need to take the difference with the modulus in this case
+                    if (adjusted_ptr < base_ptr) {
+                        auto sub = BlueprintFieldType::modulus - static_cast<typename BlueprintFieldType::integral_type>(var_value(assignments[currProverIdx], gep_initial_idx).data);
+                        resolved_idx = static_cast<int>(sub) * -1;
+                    } else {
+                        resolved_idx = resolve_number<int>(gep_initial_idx);
+                    }
                 }
                 size_t type_size = layout_resolver->get_type_size(gep_ty);
+                size_t cells_for_type = layout_resolver->get_type_layout<BlueprintFieldType>(gep_ty).size();
                 size_t offset_diff = resolved_idx * type_size;
                 size_t desired_offset = stack_memory[base_ptr_number].offset + offset_diff;
-
-                if (resolved_idx < 0) {
-                    ptr_type left_border = base_ptr_number + resolved_idx * type_size;
-                    ptr_type right_border = base_ptr_number;
-                    return find_offset(left_border, right_border, desired_offset);
-                } else {
-                    ptr_type left_border = base_ptr_number;
-                    ptr_type right_border = base_ptr_number + resolved_idx * type_size;
-                    return find_offset(left_border, right_border, desired_offset);
-                }
+                return stack_memory.offset_to_ptr(desired_offset, base_ptr_number + resolved_idx * cells_for_type);
             }
 
-            typename BlueprintFieldType::value_type handle_gep(const llvm::GetElementPtrInst* gep, stack_frame<var> &frame) {
+            typename BlueprintFieldType::value_type handle_gep(const decoded_instruction &op, stack_frame<var> &frame) {
+                auto *gep = llvm::cast<llvm::GetElementPtrInst>(op.inst);
                 llvm::Type *gep_ty = gep->getSourceElementType();
-                auto ptr_number = handle_initial_gep_adjustment(gep, frame, gep_ty);
+                auto ptr_number = handle_initial_gep_adjustment(op, frame, gep_ty);
                 ASSERT(stack_memory[ptr_number].size != 0);
 
                 if (gep->getNumIndices() > 1) {
@@ -594,39 +620,118 @@ namespace nil {
                     // Collect GEP indices
                     std::vector<int> gep_indices;
                     for (unsigned i = 1; i < gep->getNumIndices(); ++i) {
-                        int gep_index = resolve_number<int>(frame, gep->getOperand(i + 1));
+                        int gep_index = resolve_number<int>(frame, op.operands[i + 1]);
                         gep_indices.push_back(gep_index);
                     }
                     auto [resolved_offset, hint] = layout_resolver->resolve_offset_with_index_hint<BlueprintFieldType>(gep_ty, gep_indices);
-                    size_t expected_offset = stack_memory[ptr_number].offset + resolved_offset;
-                    while (stack_memory[ptr_number + hint].size == 0) {
-                        ++hint;
-                    };
                     size_t desired_offset = stack_memory[ptr_number].offset + resolved_offset;
+                    ptr_number = stack_memory.offset_to_ptr(desired_offset, ptr_number + hint);
+                }
+                return ptr_number;
+            }
+
+            // Same as handle_gep, all the indices of a constant expression are known
+            ptr_type handle_constant_gep(const llvm::ConstantExpr *expr, stack_frame<var> &frame) {
+                auto *gep = llvm::cast<llvm::GEPOperator>(expr);
+                const llvm::Value *base = gep->getPointerOperand();
+                var base_ptr_var = llvm::isa<llvm::GlobalValue>(base) ? globals[base] : frame.scalars[base];
+                ptr_type ptr_number = resolve_number<ptr_type>(base_ptr_var);
+                llvm::Type *gep_ty = gep->getSourceElementType();
+                auto gep_index = [gep](unsigned i) {
+                    return static_cast<int>(llvm::cast<llvm::ConstantInt>(gep->getOperand(i + 1))->getSExtValue());
+                };
+
+                int initial_idx = gep_index(0);
+                if (initial_idx != 0) {
                     size_t type_size = layout_resolver->get_type_size(gep_ty);
-                    ptr_number = find_offset(ptr_number + hint, ptr_number + type_size, desired_offset);
+                    size_t cells_for_type = layout_resolver->get_type_layout<BlueprintFieldType>(gep_ty).size();
+                    size_t desired_offset = stack_memory[ptr_number].offset + initial_idx * type_size;
+                    ptr_number = stack_memory.offset_to_ptr(desired_offset, ptr_number + initial_idx * cells_for_type);
+                }
+                if (gep->getNumIndices() > 1) {
+                    ASSERT_MSG(gep_ty->isAggregateType(), "GEP constant expression with > 1 indices must operate on aggregate type");
+                    std::vector<int> gep_indices;
+                    for (unsigned i = 1; i < gep->getNumIndices(); ++i) {
+                        gep_indices.push_back(gep_index(i));
+                    }
+                    auto [resolved_offset, hint] = layout_resolver->resolve_offset_with_index_hint<BlueprintFieldType>(gep_ty, gep_indices);
+                    size_t desired_offset = stack_memory[ptr_number].offset + resolved_offset;
+                    ptr_number = stack_memory.offset_to_ptr(desired_offset, ptr_number + hint);
                 }
                 return ptr_number;
             }
 
-            void handle_ptrtoint(const llvm::Value *inst, llvm::Value *operand, stack_frame<var> &frame) {
+            void handle_ptrtoint(std::uint32_t result, std::uint32_t operand, stack_frame<var> &frame) {
                 ptr_type ptr = resolve_number<ptr_type>(frame, operand);
                 size_t offset = stack_memory.ptrtoint(ptr);
                 log.debug("PtrToInt {} {}", ptr, offset);
-                frame.scalars[inst] = put_into_assignment(offset);
+                frame.scalars.at_slot(result) = put_host_value(offset);
+            }
+
+            // Constants are immutable, so a public input cell with the value can be shared by all the uses.
+            // The pool is kept per prover, cells of another prover are not accessible without copying
+            void reset_constant_pool() {
+                constant_pool.clear();
+                constant_values.clear();
+                constant_pool_prover = currProverIdx;
+            }
+
+            var put_constant_value(const typename BlueprintFieldType::value_type &value) {
+                if (constant_pool_prover != currProverIdx) {
+                    reset_constant_pool();
+                }
+                typename BlueprintFieldType::integral_type key(value.data);
+                auto it = constant_values.find(key);
+                if (it != constant_values.end()) {
+                    return it->second;
+                }
+                var variable = put_into_assignment(value);
+                constant_values.emplace(key, variable);
+                return variable;
+            }
+
+            const std::vector<var> &intern_constant(const llvm::Constant *c) {
+                if (constant_pool_prover != currProverIdx) {
+                    reset_constant_pool();
+                }
+                auto it = constant_pool.find(c);
+                if (it != constant_pool.end()) {
+                    return it->second;
+                }
+                std::vector<var> result;
+                if (auto *cv = llvm::dyn_cast<llvm::ConstantVector>(c)) {
+                    size_t size = cv->getType()->getNumElements();
+                    std::size_t arg_num = field_arg_num<BlueprintFieldType>(cv->getType()->getElementType());
+                    result.resize(size * arg_num);
+
+                    ASSERT(cv->getType()->getElementType()->isFieldTy());
+
+                    for (int i = 0; i < size; ++i) {
+                        llvm::Constant *elem = cv->getAggregateElement(i);
+                        if (llvm::isa<llvm::UndefValue>(elem))
+                            continue;
+                        std::vector<typename BlueprintFieldType::value_type> marshalled_field_val = marshal_field_val<BlueprintFieldType>(elem);
+                        for (std::size_t j = 0; j < marshalled_field_val.size(); j++) {
+                            result[i * arg_num + j] = put_constant_value(marshalled_field_val[j]);
+                        }
+                    }
+                } else {
+                    std::vector<typename BlueprintFieldType::value_type> marshalled_field_val = marshal_field_val<BlueprintFieldType>(c);
+                    for (std::size_t i = 0; i < marshalled_field_val.size(); i++) {
+                        result.push_back(put_constant_value(marshalled_field_val[i]));
+                    }
+                }
+                return constant_pool.emplace(c, std::move(result)).first->second;
             }
 
             void put_constant(llvm::Constant *c, stack_frame<var> &frame) {
                 if (llvm::isa<llvm::ConstantField>(c) || llvm::isa<llvm::ConstantInt>(c)) {
-                    std::vector<typename BlueprintFieldType::value_type> marshalled_field_val = marshal_field_val<BlueprintFieldType>(c);
-                    if (marshalled_field_val.size() == 1) {
-                        frame.scalars[c] = put_into_assignment(marshalled_field_val[0]);
+                    const std::vector<var> &interned = intern_constant(c);
+                    if (interned.size() == 1) {
+                        frame.scalars[c] = interned[0];
                     }
                     else {
-                        frame.vectors[c] = {};
-                        for (std::size_t i = 0; i < marshalled_field_val.size(); i++) {
-                            frame.vectors[c].push_back(put_into_assignment(marshalled_field_val[i]));
-                        }
+                        frame.vectors[c] = interned;
                     }
                 } else if (llvm::isa<llvm::UndefValue>(c)) {
                     llvm::Type *undef_type = c->getType();
@@ -637,40 +742,29 @@ namespace nil {
                         frame.vectors[c] = std::vector<var>(vector_type->getNumElements() * arg_num, undef_var);
                     } else {
                         ASSERT(undef_type->isAggregateType());
-                        auto layout = layout_resolver->get_type_layout<BlueprintFieldType>(undef_type);
+                        const auto &layout = layout_resolver->get_type_layout<BlueprintFieldType>(undef_type);
                         ptr_type ptr = stack_memory.add_cells(layout);
                         for (size_t i = 0; i < layout.size(); ++i) {
                             stack_memory.store(ptr+i, undef_var);
                         }
-                        frame.scalars[c] = put_into_assignment(ptr);
+                        frame.scalars[c] = put_host_value(ptr);
                     }
                 } else if (llvm::isa<llvm::ConstantPointerNull>(c)) {
                     frame.scalars[c] = zero_var;
-                } else if (auto *cv = llvm::dyn_cast<llvm::ConstantVector>(c)) {
-                    size_t size = cv->getType()->getNumElements();
-                    std::size_t arg_num = field_arg_num<BlueprintFieldType>(cv->getType()->getElementType());
-                    std::vector<var> result_vector(size * arg_num);
-
-                    ASSERT(cv->getType()->getElementType()->isFieldTy());
-
-                    for (int i = 0; i < size; ++i) {
-                        llvm::Constant *elem = cv->getAggregateElement(i);
-                        if (llvm::isa<llvm::UndefValue>(elem))
-                            continue;
-                        std::vector<typename BlueprintFieldType::value_type> marshalled_field_val = marshal_field_val<BlueprintFieldType>(elem);
-                        for (std::size_t j = 0; j < marshalled_field_val.size(); j++) {
-                            result_vector[i * arg_num + j] = put_into_assignment(marshalled_field_val[j]);
-                        }
-
-                    }
-                    frame.vectors[c] = result_vector;
+                } else if (llvm::isa<llvm::ConstantVector>(c)) {
+                    frame.vectors[c] = intern_constant(c);
                 } else if (auto expr = llvm::dyn_cast<llvm::ConstantExpr>(c)) {
-                    for (int i = 0; i < expr->getNumOperands(); ++i) {
+                    // Indices of a GEP are read from the expression itself, only its base needs a value
+                    int operands_amount = expr->getOpcode() == llvm::Instruction::GetElementPtr ? 1 : expr->getNumOperands();
+                    for (int i = 0; i < operands_amount; ++i) {
                         put_constant(expr->getOperand(i), frame);
                     }
                     switch (expr->getOpcode()) {
                     case llvm::Instruction::PtrToInt:
-                        handle_ptrtoint(expr, expr->getOperand(0), frame);
+                        handle_ptrtoint(frame.numbering->slot(expr), frame.numbering->slot(expr->getOperand(0)), frame);
+                        break;
+                    case llvm::Instruction::GetElementPtr:
+                        frame.scalars[c] = put_host_value(handle_constant_gep(expr, frame));
                         break;
                     default:
                         UNREACHABLE(std::string("Unhandled constant expression: ") + expr->getOpcodeName());
@@ -684,7 +778,56 @@ namespace nil {
                 }
             }
 
-            const llvm::Instruction *handle_instruction(const llvm::Instruction *inst) {
+            // Handlers of these instructions only pass operands to components and don't need their values
+            static bool reads_operand_values(const decoded_instruction &op) {
+                switch (op.handler) {
+                    case op_handler::INTEGER_ADDITION:
+                    case op_handler::FIELD_ADDITION:
+                    case op_handler::CURVE_ADDITION:
+                    case op_handler::INTEGER_SUBTRACTION:
+                    case op_handler::FIELD_SUBTRACTION:
+                    case op_handler::CURVE_SUBTRACTION:
+                    case op_handler::INTEGER_MULTIPLICATION:
+                    case op_handler::FIELD_MULTIPLICATION:
+                    case op_handler::CURVE_MULTIPLICATION:
+                    case op_handler::INTEGER_DIVISION:
+                    case op_handler::INTEGER_QUOTIENT:
+                    case op_handler::INTEGER_REMAINDER:
+                    case op_handler::FIELD_DIVISION:
+                    case op_handler::VECTOR_CMP:
+                    case op_handler::CURVE_CMP:
+                    case op_handler::CALL:
+                    case op_handler::PHI:
+                        return false;
+                    case op_handler::SCALAR_CMP:
+                        return !llvm::cast<llvm::ICmpInst>(op.inst)->isEquality();
+                    case op_handler::INTRINSIC:
+                        return op.intrinsic_id != llvm::Intrinsic::assigner_poseidon &&
+                               op.intrinsic_id != llvm::Intrinsic::assigner_sha2_256 &&
+                               op.intrinsic_id != llvm::Intrinsic::assigner_sha2_512;
+                    default:
+                        return true;
+                }
+            }
+
+            bool has_pending_operands(const decoded_instruction &op, const stack_frame<var> &frame) const {
+                for (std::uint32_t slot : op.operands) {
+                    if (frame.scalars.contains_slot(slot) && scheduler.is_pending(frame.scalars.at_slot(slot))) {
+                        return true;
+                    }
+                    if (frame.vectors.contains_slot(slot)) {
+                        for (const var &v : frame.vectors.at_slot(slot)) {
+                            if (scheduler.is_pending(v)) {
+                                return true;
+                            }
+                        }
+                    }
+                }
+                return false;
+            }
+
+            std::size_t handle_instruction(const decoded_instruction &op) {
+                const llvm::Instruction *inst = op.inst;
                 log.log_instruction(inst);
                 stack_frame<var> &frame = call_stack.top();
                 auto &variables = frame.scalars;
@@ -692,31 +835,23 @@ namespace nil {
 
                 // Put constant operands to public input
                 for (int i = 0; i < inst->getNumOperands(); ++i) {
-                    llvm::Value *op = inst->getOperand(i);
-                    if (variables.find(op) != variables.end()) {
+                    llvm::Value *operand = inst->getOperand(i);
+                    if (variables.contains_slot(op.operands[i])) {
                         continue;
                     }
-                    if (llvm::isa<llvm::GlobalValue>(op)) {
-                        frame.scalars[op] = globals[op];
-                    } else if (llvm::isa<llvm::Constant>(op)) {
+                    if (llvm::isa<llvm::GlobalValue>(operand)) {
+                        frame.scalars.at_slot(op.operands[i]) = globals[operand];
+                    } else if (llvm::isa<llvm::Constant>(operand)) {
                         // We are replacing constant handling with passing them directly to a component
                         // For now this functionality is supported only for intrinsics
                         // In other cases the logic remains unchanged
-                        if (inst->getOpcode() != llvm::Instruction::Call ||
-                            !llvm::cast<llvm::CallInst>(inst)->getCalledFunction()->isIntrinsic()) {
-                            put_constant(llvm::cast<llvm::Constant>(op), frame);
+                        if (op.handler != op_handler::INTRINSIC) {
+                            put_constant(llvm::cast<llvm::Constant>(operand), frame);
                         }
                     }
                 }
 
-                // extract zk related metadata
-                const std::string metadataStr = extract_metadata(inst);
-                std::uint32_t userProverIdx = currProverIdx;
-                try {
-                    userProverIdx = std::stoi(metadataStr);
-                } catch(...) {
-                    userProverIdx = currProverIdx;
-                }
+                std::uint32_t userProverIdx = op.prover_idx.value_or(currProverIdx);
 
                 if (userProverIdx < currProverIdx || userProverIdx >= maxNumProvers) {
                     std::cout << "WARNING: ignored user defined prover index " << userProverIdx
@@ -732,293 +867,225 @@ namespace nil {
                     circuits.emplace_back(bp_ptr, currProverIdx);
                 }
 
-                bool next_prover = false;
-                if (inst->getNextNonDebugInstruction()) {
-                    const std::string nextInstructionMetadataStr = extract_metadata(inst->getNextNonDebugInstruction());
-                    try {
-                        const std::uint32_t nextUserProverIdx = std::stoi(nextInstructionMetadataStr);
-                        next_prover = currProverIdx != nextUserProverIdx;
-                    } catch(...) {
-                        next_prover = false;
-                    }
-                }
-
-                switch (inst->getOpcode()) {
-                    case llvm::Instruction::Add: {
-
-                        if (inst->getOperand(0)->getType()->isIntegerTy()) {
-                            handle_integer_addition_component<BlueprintFieldType, ArithmetizationParams>(
-                                        inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        }
-
-                        if (inst->getOperand(0)->getType()->isFieldTy() && inst->getOperand(1)->getType()->isFieldTy()) {
-                            handle_field_addition_component<BlueprintFieldType, ArithmetizationParams>(
-                                        inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        } else if (inst->getOperand(0)->getType()->isCurveTy() && inst->getOperand(1)->getType()->isCurveTy()) {
-                            handle_curve_addition_component<BlueprintFieldType, ArithmetizationParams>(
-                                        inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        } else {
-                            UNREACHABLE("curve + scalar is undefined");
-                        }
-
-                        return inst->getNextNonDebugInstruction();
-                    }
-                    case llvm::Instruction::Sub: {
-                        if (inst->getOperand(0)->getType()->isIntegerTy()) {
-                            handle_integer_subtraction_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        }
-
-                        if (inst->getOperand(0)->getType()->isFieldTy() && inst->getOperand(1)->getType()->isFieldTy()) {
-                            handle_field_subtraction_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        } else if (inst->getOperand(0)->getType()->isCurveTy() && inst->getOperand(1)->getType()->isCurveTy()) {
-                            handle_curve_subtraction_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        } else {
-                            UNREACHABLE("curve - scalar is undefined");
-                        }
-
-                        return inst->getNextNonDebugInstruction();
-                    }
-                    case llvm::Instruction::Mul: {
-
-                        if (inst->getOperand(0)->getType()->isIntegerTy()) {
-                            handle_integer_multiplication_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        }
-
-                        if (inst->getOperand(0)->getType()->isFieldTy() && inst->getOperand(1)->getType()->isFieldTy()) {
-                            handle_field_multiplication_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        }
-
-                        UNREACHABLE("Mul opcode is defined only for fieldTy and integerTy");
-
-                        return inst->getNextNonDebugInstruction();
-                    }
-                    case llvm::Instruction::CMul: {
-                        if (
-                            (inst->getOperand(0)->getType()->isCurveTy() && inst->getOperand(1)->getType()->isFieldTy()) ||
-                            (inst->getOperand(1)->getType()->isCurveTy() && inst->getOperand(0)->getType()->isFieldTy())) {
-
-                            handle_curve_multiplication_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        } else {
-                            UNREACHABLE("cmul opcode is defined only for curveTy * fieldTy");
-                        }
-                    }
-                    case llvm::Instruction::UDiv: {
-                        if (inst->getOperand(0)->getType()->isIntegerTy() && inst->getOperand(1)->getType()->isIntegerTy()) {
-                            handle_integer_division_remainder_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, true, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        }
-                        else if (inst->getOperand(0)->getType()->isFieldTy() && inst->getOperand(1)->getType()->isFieldTy()) {
-                            handle_field_division_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        }
-                        else {
-                            UNREACHABLE("UDiv opcode is defined only for integerTy and fieldTy");
-                        }
-                    }
-                    case llvm::Instruction::URem: {
-                        if (inst->getOperand(0)->getType()->isIntegerTy() && inst->getOperand(1)->getType()->isIntegerTy()) {
-                            handle_integer_division_remainder_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, false, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        } else {
-                            UNREACHABLE("URem opcode is defined only for integerTy");
-                        }
-                    }
-                    case llvm::Instruction::Shl: {
-                        if (inst->getOperand(0)->getType()->isIntegerTy() && inst->getOperand(1)->getType()->isIntegerTy()) {
-                            handle_integer_bit_shift_constant_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row,
-                                        nil::blueprint::components::bit_shift_mode::LEFT, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        } else {
-                            UNREACHABLE("shl opcode is defined only for integerTy");
-                        }
-                    }
-                    case llvm::Instruction::LShr: {
-                        if (inst->getOperand(0)->getType()->isIntegerTy() && inst->getOperand(1)->getType()->isIntegerTy()) {
-                            handle_integer_bit_shift_constant_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row,
-                                        nil::blueprint::components::bit_shift_mode::RIGHT, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        } else {
-                            UNREACHABLE("LShr opcode is defined only for integerTy");
-                        }
-                    }
-                    case llvm::Instruction::SDiv: {
+                bool next_prover = op.next_prover_idx && *op.next_prover_idx != currProverIdx;
 
-                        if (inst->getOperand(0)->getType()->isIntegerTy()) {
-                            handle_integer_division_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        }
-
-                        if (inst->getOperand(0)->getType()->isFieldTy() && inst->getOperand(1)->getType()->isFieldTy()) {
-                            handle_field_division_component<BlueprintFieldType, ArithmetizationParams>(
-                                inst, frame, circuits[currProverIdx], assignments[currProverIdx], start_row, next_prover);
-                            return inst->getNextNonDebugInstruction();
-                        }
-
-                        return inst->getNextNonDebugInstruction();
+                // Values shared with the next prover are copied right away, so they can't be deferred
+                if (scheduler.has_pending() && (next_prover || (reads_operand_values(op) && has_pending_operands(op, frame)))) {
+                    scheduler.flush(assignments);
+                }
+                scheduler.set_deferring(!next_prover);
+
+                switch (op.handler) {
+                    case op_handler::INTEGER_ADDITION: {
+                        handle_integer_addition_component<BlueprintFieldType, ArithmetizationParams>(
+                                    op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::FIELD_ADDITION: {
+                        handle_field_addition_component<BlueprintFieldType, ArithmetizationParams>(
+                                    op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::CURVE_ADDITION: {
+                        handle_curve_addition_component<BlueprintFieldType, ArithmetizationParams>(
+                                    op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::INTEGER_SUBTRACTION: {
+                        handle_integer_subtraction_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::FIELD_SUBTRACTION: {
+                        handle_field_subtraction_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::CURVE_SUBTRACTION: {
+                        handle_curve_subtraction_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::INTEGER_MULTIPLICATION: {
+                        handle_integer_multiplication_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::FIELD_MULTIPLICATION: {
+                        handle_field_multiplication_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::CURVE_MULTIPLICATION: {
+                        handle_curve_multiplication_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::INTEGER_QUOTIENT: {
+                        handle_integer_division_remainder_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, true, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::INTEGER_REMAINDER: {
+                        handle_integer_division_remainder_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, false, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::INTEGER_DIVISION: {
+                        handle_integer_division_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::FIELD_DIVISION: {
+                        handle_field_division_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::SHIFT_LEFT: {
+                        handle_integer_bit_shift_constant_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row,
+                                    nil::blueprint::components::bit_shift_mode::LEFT, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::SHIFT_RIGHT: {
+                        handle_integer_bit_shift_constant_component<BlueprintFieldType, ArithmetizationParams>(
+                            op, frame, circuits[currProverIdx], assignments[currProverIdx], generation, start_row,
+                                    nil::blueprint::components::bit_shift_mode::RIGHT, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::INTRINSIC: {
+                        auto *call_inst = llvm::cast<llvm::CallInst>(inst);
+                        ASSERT(call_inst->getCalledFunction()->arg_size() == call_inst->getNumOperands() - 1);
+                        if (!handle_intrinsic(op, frame, start_row, next_prover))
+                            return decoded_program::npos;
+                        return op.next;
                     }
-                    case llvm::Instruction::Call: {
+                    case op_handler::CALL: {
                         auto *call_inst = llvm::cast<llvm::CallInst>(inst);
                         auto *fun = call_inst->getCalledFunction();
-                        if (fun == nullptr) {
-                            std::cerr << "Unresolved call";
-                            return nullptr;
-                        }
-                        llvm::StringRef fun_name = fun->getName();
                         ASSERT(fun->arg_size() == call_inst->getNumOperands() - 1);
-                        if (fun->isIntrinsic()) {
-                            if (!handle_intrinsic(call_inst, fun->getIntrinsicID(), frame, start_row, next_prover))
-                                return nullptr;
-                            return inst->getNextNonDebugInstruction();
-                        }
-                        if (fun->empty()) {
-                            UNREACHABLE("Function " + fun_name.str() + " has no implementation.");
-                        }
-                        stack_frame<var> new_frame;
+                        stack_frame<var> new_frame(program.get_numbering(*fun));
                         auto &new_variables = new_frame.scalars;
+                        // Arguments are numbered first, so the slot of an argument is its index
                         for (int i = 0; i < fun->arg_size(); ++i) {
                             llvm::Argument *arg = fun->getArg(i);
                             llvm::Type *arg_type = arg->getType();
                             if (arg->getType()->isVectorTy() || arg->getType()->isCurveTy() ||
                                 (arg->getType()->isFieldTy() && field_arg_num<BlueprintFieldType>(arg_type) > 1)) {
-                                new_frame.vectors[arg] = frame.vectors[call_inst->getOperand(i)];
+                                new_frame.vectors.at_slot(i) = frame.vectors.at_slot(op.operands[i]);
                             }
                             else
-                                new_variables[arg] = variables[call_inst->getOperand(i)];
+                                new_variables.at_slot(i) = variables.at_slot(op.operands[i]);
 
                         }
                         new_frame.caller = call_inst;
+                        new_frame.return_idx = op.next;
+                        new_frame.return_slot = op.result;
                         call_stack.emplace(std::move(new_frame));
                         stack_memory.push_frame();
-                        return &fun->begin()->front();
-                    }
-                    case llvm::Instruction::ICmp: {
-                        auto cmp_inst = llvm::cast<const llvm::ICmpInst>(inst);
-                        llvm::Type *cmp_type = cmp_inst->getOperand(0)->getType();
-                        if (cmp_type->isIntegerTy()|| cmp_type->isFieldTy())
-                            handle_scalar_cmp(cmp_inst, variables, next_prover);
-                        else if (cmp_type->isPointerTy())
-                            handle_ptr_cmp(cmp_inst, frame);
-                        else if (cmp_type->isVectorTy())
-                            handle_vector_cmp(cmp_inst, frame, next_prover);
-                        else if (cmp_type->isCurveTy())
-                            handle_curve_cmp(cmp_inst, frame, next_prover);
-                        else {
-                            UNREACHABLE("Unsupported icmp operand type");
-                        }
-                        return inst->getNextNonDebugInstruction();
+                        return op.successors[0];
+                    }
+                    case op_handler::SCALAR_CMP: {
+                        handle_scalar_cmp(op, variables, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::POINTER_CMP: {
+                        handle_ptr_cmp(op, frame);
+                        return op.next;
+                    }
+                    case op_handler::VECTOR_CMP: {
+                        handle_vector_cmp(op, frame, next_prover);
+                        return op.next;
+                    }
+                    case op_handler::CURVE_CMP: {
+                        handle_curve_cmp(op, frame, next_prover);
+                        return op.next;
                     }
-                    case llvm::Instruction::Select: {
+                    case op_handler::SELECT: {
 
-                        var condition = variables[inst->getOperand(0)];
-                        llvm::Value *true_val = inst->getOperand(1);
-                        llvm::Value *false_val = inst->getOperand(2);
+                        var condition = variables.at_slot(op.operands[0]);
                         if (var_value(assignments[currProverIdx], condition) != 0) {
-                            variables[inst] = variables[true_val];
+                            variables.at_slot(op.result) = variables.at_slot(op.operands[1]);
                         } else {
-                            variables[inst] = variables[false_val];
+                            variables.at_slot(op.result) = variables.at_slot(op.operands[2]);
                         }
-                        return inst->getNextNonDebugInstruction();
+                        return op.next;
                     }
-                    case llvm::Instruction::And: {
+                    case op_handler::AND: {
 
-                        const var &lhs = variables[inst->getOperand(0)];
-                        const var &rhs = variables[inst->getOperand(1)];
+                        const var &lhs = variables.at_slot(op.operands[0]);
+                        const var &rhs = variables.at_slot(op.operands[1]);
 
                         // TODO: replace mock with component
 
                         typename BlueprintFieldType::integral_type x_integer(var_value(assignments[currProverIdx], lhs).data);
                         typename BlueprintFieldType::integral_type y_integer(var_value(assignments[currProverIdx], rhs).data);
                         typename BlueprintFieldType::value_type res = (x_integer & y_integer);
-                        variables[inst] = put_into_assignment(res);
+                        variables.at_slot(op.result) = put_host_value(res);
 
-                        return inst->getNextNonDebugInstruction();
+                        return op.next;
                     }
-                    case llvm::Instruction::Or: {
+                    case op_handler::OR: {
 
-                        const var &lhs = variables[inst->getOperand(0)];
-                        const var &rhs = variables[inst->getOperand(1)];
+                        const var &lhs = variables.at_slot(op.operands[0]);
+                        const var &rhs = variables.at_slot(op.operands[1]);
 
                         // TODO: replace mock with component
 
                         typename BlueprintFieldType::integral_type x_integer(var_value(assignments[currProverIdx], lhs).data);
                         typename BlueprintFieldType::integral_type y_integer(var_value(assignments[currProverIdx], rhs).data);
                         typename BlueprintFieldType::value_type res = (x_integer | y_integer);
-                        variables[inst] = put_into_assignment(res);
+                        variables.at_slot(op.result) = put_host_value(res);
 
-                        return inst->getNextNonDebugInstruction();
+                        return op.next;
                     }
-                    case llvm::Instruction::Xor: {
+                    case op_handler::XOR: {
 
-                        const var &lhs = variables[inst->getOperand(0)];
-                        const var &rhs = variables[inst->getOperand(1)];
+                        const var &lhs = variables.at_slot(op.operands[0]);
+                        const var &rhs = variables.at_slot(op.operands[1]);
 
                         // TODO: replace mock with component
 
                         typename BlueprintFieldType::integral_type x_integer(var_value(assignments[currProverIdx], lhs).data);
                         typename BlueprintFieldType::integral_type y_integer(var_value(assignments[currProverIdx], rhs).data);
                         typename BlueprintFieldType::value_type res = (x_integer ^ y_integer);
-                        variables[inst] = put_into_assignment(res);
+                        variables.at_slot(op.result) = put_host_value(res);
 
-                        return inst->getNextNonDebugInstruction();
+                        return op.next;
                     }
-                    case llvm::Instruction::Br: {
+                    case op_handler::BR: {
                         // Save current basic block to resolve PHI inst further
                         predecessor = inst->getParent();
 
-                        if (inst->getNumOperands() != 1) {
-                            ASSERT(inst->getNumOperands() == 3);
-                            auto false_bb = llvm::cast<llvm::BasicBlock>(inst->getOperand(1));
-                            auto true_bb = llvm::cast<llvm::BasicBlock>(inst->getOperand(2));
-                            var cond = variables[inst->getOperand(0)];
+                        if (op.successors.size() != 1) {
+                            var cond = variables.at_slot(op.operands[0]);
                             if (var_value(assignments[currProverIdx], cond) != 0)
-                                return &true_bb->front();
-                            return &false_bb->front();
+                                return op.successors[1];
+                            return op.successors[0];
                         }
-                        auto bb_to_jump = llvm::cast<llvm::BasicBlock>(inst->getOperand(0));
-                        return &bb_to_jump->front();
+                        return op.successors[0];
                     }
-                    case llvm::Instruction::PHI: {
+                    case op_handler::PHI: {
                         auto phi_node = llvm::cast<llvm::PHINode>(inst);
                         for (int i = 0; i < phi_node->getNumIncomingValues(); ++i) {
                             if (phi_node->getIncomingBlock(i) == predecessor) {
-                                llvm::Value *incoming_value = phi_node->getIncomingValue(i);
-                                llvm::Type *value_type = incoming_value->getType();
+                                std::uint32_t incoming_value = op.operands[i];
+                                llvm::Type *value_type = phi_node->getType();
                                 if (value_type->isIntegerTy() || value_type->isPointerTy() ||
                                            (value_type->isFieldTy() && field_arg_num<BlueprintFieldType>(value_type) == 1)) {
-                                    ASSERT(variables.find(incoming_value) != variables.end());
-                                    variables[phi_node] = variables[incoming_value];
+                                    ASSERT(variables.contains_slot(incoming_value));
+                                    variables.at_slot(op.result) = variables.at_slot(incoming_value);
                                 } else {
-                                    ASSERT(frame.vectors.find(incoming_value) != frame.vectors.end());
-                                    frame.vectors[phi_node] = frame.vectors[incoming_value];
+                                    ASSERT(frame.vectors.contains_slot(incoming_value));
+                                    frame.vectors.at_slot(op.result) = frame.vectors.at_slot(incoming_value);
                                 }
-                                return phi_node->getNextNonDebugInstruction();
+                                return op.next;
                             }
                         }
                         UNREACHABLE("Incoming value for phi was not found");
                         break;
                     }
-                    case llvm::Instruction::Switch: {
+                    case op_handler::SWITCH: {
                         // Save current basic block to resolve PHI inst further
                         predecessor = inst->getParent();
 
@@ -1027,136 +1094,122 @@ namespace nil {
                         ASSERT(cond->getType()->isIntegerTy());
                         unsigned bit_width = llvm::cast<llvm::IntegerType>(cond->getType())->getBitWidth();
                         ASSERT(bit_width <= 64);
-                        auto cond_var = var_value(assignments[currProverIdx], frame.scalars[cond]);
+                        auto cond_var = var_value(assignments[currProverIdx], frame.scalars.at_slot(op.operands[0]));
                         auto cond_val = llvm::APInt(
                             bit_width,
                             (int64_t) static_cast<typename BlueprintFieldType::integral_type>(cond_var.data));
+                        std::size_t case_idx = 1;
                         for (auto Case : switch_inst->cases()) {
                             if (Case.getCaseValue()->getValue().eq(cond_val)) {
-                                return &Case.getCaseSuccessor()->front();
+                                return op.successors[case_idx];
                             }
+                            ++case_idx;
                         }
-                        return &switch_inst->getDefaultDest()->front();
-                        break;
+                        return op.successors[0];
                     }
-                    case llvm::Instruction::InsertElement: {
+                    case op_handler::INSERT_ELEMENT: {
                         auto insert_inst = llvm::cast<llvm::InsertElementInst>(inst);
-                        llvm::Value *vec = insert_inst->getOperand(0);
                         llvm::Value *index_value = insert_inst->getOperand(2);
-                        if (!llvm::isa<llvm::ConstantInt>(index_value)) {
-                            std::cerr << "Only constant indices for a vector are supported" << std::endl;
-                            return nullptr;
-                        }
-
                         int index = llvm::cast<llvm::ConstantInt>(index_value)->getZExtValue();
-                        std::vector<var> result_vector = frame.vectors[vec];
-                        result_vector[index] = variables[inst->getOperand(1)];
-                        frame.vectors[inst] = result_vector;
-                        return inst->getNextNonDebugInstruction();
+                        std::vector<var> result_vector = frame.vectors.at_slot(op.operands[0]);
+                        result_vector[index] = variables.at_slot(op.operands[1]);
+                        frame.vectors.at_slot(op.result) = result_vector;
+                        return op.next;
                     }
-                    case llvm::Instruction::ExtractElement: {
+                    case op_handler::EXTRACT_ELEMENT: {
                         auto extract_inst = llvm::cast<llvm::ExtractElementInst>(inst);
-                        llvm::Value *vec = extract_inst->getOperand(0);
                         llvm::Value *index_value = extract_inst->getOperand(1);
-                        if (!llvm::isa<llvm::ConstantInt>(index_value)) {
-                            std::cerr << "Only constant indices for a vector are supported" << std::endl;
-                            return nullptr;
-                        }
                         int index = llvm::cast<llvm::ConstantInt>(index_value)->getZExtValue();
-                        variables[inst] = frame.vectors[vec][index];
-                        return inst->getNextNonDebugInstruction();
+                        variables.at_slot(op.result) = frame.vectors.at_slot(op.operands[0])[index];
+                        return op.next;
                     }
-                    case llvm::Instruction::Alloca: {
+                    case op_handler::ALLOCA: {
                         auto *alloca = llvm::cast<llvm::AllocaInst>(inst);
-                        auto vec = layout_resolver->get_type_layout<BlueprintFieldType>(alloca->getAllocatedType());
+                        const auto &layout = layout_resolver->get_type_layout<BlueprintFieldType>(alloca->getAllocatedType());
 
-                        ptr_type res_ptr = stack_memory.add_cells(vec);
+                        ptr_type res_ptr = stack_memory.add_cells(layout);
                         log.debug("Alloca: {}", res_ptr);
-                        frame.scalars[inst] = put_into_assignment(res_ptr);
-                        return inst->getNextNonDebugInstruction();
+                        frame.scalars.at_slot(op.result) = put_host_value(res_ptr);
+                        return op.next;
                     }
-                    case llvm::Instruction::GetElementPtr: {
-                        auto *gep = llvm::cast<llvm::GetElementPtrInst>(inst);
-                        auto gep_res = handle_gep(gep, frame);
+                    case op_handler::GEP: {
+                        auto gep_res = handle_gep(op, frame);
                         if (gep_res == 0) {
                             std::cerr << "Incorrect GEP result!" << std::endl;
-                            return nullptr;
+                            return decoded_program::npos;
                         }
                         std::ostringstream oss;
                         oss << gep_res.data;
                         log.debug("GEP: {}", oss.str());
-                        frame.scalars[gep] = put_into_assignment(gep_res);
-                        return inst->getNextNonDebugInstruction();
+                        frame.scalars.at_slot(op.result) = put_host_value(gep_res);
+                        return op.next;
                     }
-                    case llvm::Instruction::Load: {
-                        auto *load_inst = llvm::cast<llvm::LoadInst>(inst);
-                        ptr_type ptr = resolve_number<ptr_type>(frame, load_inst->getPointerOperand());
+                    case op_handler::LOAD: {
+                        ptr_type ptr = resolve_number<ptr_type>(frame, op.operands[0]);
                         log.debug("Load: {}", ptr);
-                        handle_load(ptr, load_inst, frame);
-                        return inst->getNextNonDebugInstruction();
+                        handle_load(ptr, inst, op.result, frame);
+                        return op.next;
                     }
-                    case llvm::Instruction::Store: {
+                    case op_handler::STORE: {
                         auto *store_inst = llvm::cast<llvm::StoreInst>(inst);
-                        ptr_type ptr = resolve_number<ptr_type>(frame, store_inst->getPointerOperand());
+                        ptr_type ptr = resolve_number<ptr_type>(frame, op.operands[1]);
                         log.debug("Store: {}", ptr);
-                        const llvm::Value *val = store_inst->getValueOperand();
-                        handle_store(ptr, val, frame);
-                        return inst->getNextNonDebugInstruction();
+                        handle_store(ptr, store_inst->getValueOperand(), op.operands[0], frame);
+                        return op.next;
                     }
-                    case llvm::Instruction::InsertValue: {
+                    case op_handler::INSERT_VALUE: {
                         auto *insert_inst = llvm::cast<llvm::InsertValueInst>(inst);
-                        ptr_type ptr = resolve_number<ptr_type>(frame, insert_inst->getAggregateOperand());
+                        ptr_type ptr = resolve_number<ptr_type>(frame, op.operands[0]);
                         // TODO(maksenov): handle offset properly
                         ptr += layout_resolver->resolve_offset_with_index_hint<BlueprintFieldType>(
                             insert_inst->getAggregateOperand()->getType(), insert_inst->getIndices()).second;
-                        stack_memory.store(ptr, frame.scalars[insert_inst->getInsertedValueOperand()]);
-                        frame.scalars[inst] = frame.scalars[insert_inst->getAggregateOperand()];
-                        return inst->getNextNonDebugInstruction();
+                        stack_memory.store(ptr, frame.scalars.at_slot(op.operands[1]));
+                        frame.scalars.at_slot(op.result) = frame.scalars.at_slot(op.operands[0]);
+                        return op.next;
                     }
-                    case llvm::Instruction::ExtractValue: {
+                    case op_handler::EXTRACT_VALUE: {
                         auto *extract_inst = llvm::cast<llvm::ExtractValueInst>(inst);
-                        ptr_type ptr = resolve_number<ptr_type>(frame, extract_inst->getAggregateOperand());
+                        ptr_type ptr = resolve_number<ptr_type>(frame, op.operands[0]);
                         // TODO(maksenov): handle offset properly
                         ptr += layout_resolver->resolve_offset_with_index_hint<BlueprintFieldType>(
                             extract_inst->getAggregateOperand()->getType(), extract_inst->getIndices()).second;
-                        frame.scalars[inst] = stack_memory.load(ptr);
-                        return inst->getNextNonDebugInstruction();
+                        frame.scalars.at_slot(op.result) = stack_memory.load(ptr);
+                        return op.next;
                     }
-                    case llvm::Instruction::IndirectBr: {
-                        ptr_type ptr = resolve_number<ptr_type>(frame, inst->getOperand(0));
+                    case op_handler::INDIRECT_BR: {
+                        ptr_type ptr = resolve_number<ptr_type>(frame, op.operands[0]);
                         var bb_var = stack_memory.load(ptr);
                         llvm::BasicBlock *bb = (llvm::BasicBlock *)(resolve_number<uintptr_t>(bb_var));
                         ASSERT(labels.find(bb) != labels.end());
-                        return &bb->front();
+                        return program.get_block_start(bb);
                     }
-                    case llvm::Instruction::PtrToInt: {
-                        handle_ptrtoint(inst, inst->getOperand(0), frame);
-                        return inst->getNextNonDebugInstruction();
+                    case op_handler::PTR_TO_INT: {
+                        handle_ptrtoint(op.result, op.operands[0], frame);
+                        return op.next;
                     }
-                    case llvm::Instruction::IntToPtr: {
+                    case op_handler::INT_TO_PTR: {
                         std::ostringstream oss;
-                        size_t offset = resolve_number<size_t>(frame, inst->getOperand(0));
-                        oss << var_value(assignments[currProverIdx], frame.scalars[inst->getOperand(0)]).data;
+                        size_t offset = resolve_number<size_t>(frame, op.operands[0]);
+                        oss << var_value(assignments[currProverIdx], frame.scalars.at_slot(op.operands[0])).data;
                         ptr_type ptr = stack_memory.inttoptr(offset);
                         log.debug("IntToPtr: {} {}", oss.str(), ptr);
                         ASSERT(ptr != 0);
-                        frame.scalars[inst] = put_into_assignment(ptr);
-                        return inst->getNextNonDebugInstruction();
+                        frame.scalars.at_slot(op.result) = put_host_value(ptr);
+                        return op.next;
                     }
-                    case llvm::Instruction::Trunc: {
+                    case op_handler::TRUNC: {
                         // FIXME: Handle trunc properly. For now just leave value as it is.
-                        var x = frame.scalars[inst->getOperand(0)];
-                        frame.scalars[inst] = x;
-                        return inst->getNextNonDebugInstruction();
+                        var x = frame.scalars.at_slot(op.operands[0]);
+                        frame.scalars.at_slot(op.result) = x;
+                        return op.next;
                     }
-                    case llvm::Instruction::SExt:
-                    case llvm::Instruction::ZExt: {
+                    case op_handler::EXTENSION: {
                         // FIXME: Handle extensions properly. For now just leave value as it is.
-                        var x = frame.scalars[inst->getOperand(0)];
-                        frame.scalars[inst] = x;
-                        return inst->getNextNonDebugInstruction();
+                        var x = frame.scalars.at_slot(op.operands[0]);
+                        frame.scalars.at_slot(op.result) = x;
+                        return op.next;
                     }
-                    case llvm::Instruction::Ret: {
+                    case op_handler::RET: {
                         auto extracted_frame = std::move(call_stack.top());
                         call_stack.pop();
                         stack_memory.pop_frame();
@@ -1171,13 +1224,13 @@ namespace nil {
                                     if (ret_val->getType()->isPointerTy()) {
                                         // TODO(maksenov): support printing complex results
                                     } else if (ret_val->getType()->isVectorTy()) {
-                                        std::vector<var> res = extracted_frame.vectors[ret_val];
+                                        std::vector<var> res = extracted_frame.vectors.at_slot(op.operands[0]);
                                         for (var x : res) {
                                             std::cout << var_value(assignments[currProverIdx], x).data << " ";
                                         }
                                         std::cout << std::endl;
                                     } else if (ret_val->getType()->isFieldTy() && field_arg_num<BlueprintFieldType>(ret_val->getType()) > 1) {
-                                        std::vector<var> res = extracted_frame.vectors[ret_val];
+                                        std::vector<var> res = extracted_frame.vectors.at_slot(op.operands[0]);
                                         std::vector<typename BlueprintFieldType::value_type> chopped_field;
                                         for (std::size_t i = 0; i < res.size(); i++) {
                                             chopped_field.push_back(var_value(assignments[currProverIdx], res[i]));
@@ -1193,15 +1246,15 @@ namespace nil {
                                         std::size_t curve_len = curve_arg_num<BlueprintFieldType>(ret_val->getType());
                                         ASSERT_MSG(curve_len > 1, "curve element size must be >=2");
                                         if (curve_len == 2) {
-                                            std::cout << var_value(assignments[currProverIdx], extracted_frame.vectors[ret_val][0]).data << "\n";
-                                            std::cout << var_value(assignments[currProverIdx], extracted_frame.vectors[ret_val][1]).data << "\n";
+                                            std::cout << var_value(assignments[currProverIdx], extracted_frame.vectors.at_slot(op.operands[0])[0]).data << "\n";
+                                            std::cout << var_value(assignments[currProverIdx], extracted_frame.vectors.at_slot(op.operands[0])[1]).data << "\n";
                                         }
                                         else {
                                             llvm::GaloisFieldKind ret_field_type;
                                             ASSERT_MSG(llvm::isa<llvm::EllipticCurveType>(ret_val->getType()), "only curves can be handled here");
                                             ret_field_type  = llvm::cast<llvm::EllipticCurveType>(ret_val->getType())->GetBaseFieldKind();
 
-                                            std::vector<var> res = extracted_frame.vectors[ret_val];
+                                            std::vector<var> res = extracted_frame.vectors.at_slot(op.operands[0]);
 
                                             std::vector<typename BlueprintFieldType::value_type> chopped_field_x;
                                             std::vector<typename BlueprintFieldType::value_type> chopped_field_y;
@@ -1214,12 +1267,12 @@ namespace nil {
 
                                         }
                                     } else {
-                                        std::cout << var_value(assignments[currProverIdx], extracted_frame.scalars[ret_val]).data << std::endl;
+                                        std::cout << var_value(assignments[currProverIdx], extracted_frame.scalars.at_slot(op.operands[0])).data << std::endl;
                                     }
                                 }
                             }
 
-                            return nullptr;
+                            return decoded_program::npos;
                         }
                         if (inst->getNumOperands() != 0) {
                             llvm::Value *ret_val = inst->getOperand(0);
@@ -1227,32 +1280,35 @@ namespace nil {
                             if (ret_type->isVectorTy() || ret_type->isCurveTy()
                                     || (ret_type->isFieldTy() && field_arg_num<BlueprintFieldType>(ret_type) > 1)) {
                                 auto &upper_frame_vectors = call_stack.top().vectors;
-                                auto res = extracted_frame.vectors[ret_val];
-                                upper_frame_vectors[extracted_frame.caller] = res;
+                                auto res = extracted_frame.vectors.at_slot(op.operands[0]);
+                                upper_frame_vectors.at_slot(extracted_frame.return_slot) = res;
                             } else if (ret_type->isAggregateType()) {
-                                ptr_type ret_ptr = resolve_number<ptr_type>(extracted_frame, ret_val);
+                                ptr_type ret_ptr = resolve_number<ptr_type>(extracted_frame, op.operands[0]);
                                 ptr_type allocated_copy = stack_memory.add_cells(
                                     layout_resolver->get_type_layout<BlueprintFieldType>(ret_type));
                                 auto size = layout_resolver->get_type_size(ret_type);
                                 // TODO(maksenov): check if overwriting is possible here
                                 //                 (looks like it is not)
-                                memcpy(allocated_copy, ret_ptr, size);
+                                stack_memory.copy(allocated_copy, ret_ptr, size);
                                 auto &upper_frame_variables = call_stack.top().scalars;
 
-                                upper_frame_variables[extracted_frame.caller] = extracted_frame.scalars[ret_val];
-                                upper_frame_variables[extracted_frame.caller] = put_into_assignment(allocated_copy);
+                                upper_frame_variables.at_slot(extracted_frame.return_slot) = put_host_value(allocated_copy);
                             } else {
                                 auto &upper_frame_variables = call_stack.top().scalars;
-                                upper_frame_variables[extracted_frame.caller] = extracted_frame.scalars[ret_val];
+                                upper_frame_variables.at_slot(extracted_frame.return_slot) = extracted_frame.scalars.at_slot(op.operands[0]);
                             }
                         }
-                        return extracted_frame.caller->getNextNonDebugInstruction();
-                    }
-
-                    default:
-                        UNREACHABLE(std::string("Unsupported opcode type: ") + inst->getOpcodeName());
+                        return extracted_frame.return_idx;
+                    }
+                    case op_handler::NOP:
+                        return op.next;
+                    case op_handler::INVALID:
+                        std::cerr << op.error << std::endl;
+                        return decoded_program::npos;
+                    case op_handler::UNSUPPORTED:
+                        UNREACHABLE(op.error);
                 }
-                return nullptr;
+                return decoded_program::npos;
             }
 
         public:
@@ -1261,15 +1317,20 @@ namespace nil {
                 std::unique_ptr<llvm::Module> module = llvm::parseIRFile(ir_file, diagnostic, context);
                 if (module == nullptr) {
                     diagnostic.print("assigner", llvm::errs());
+                } else if (pre_optimization) {
+                    run_pre_optimization(*module);
                 }
                 return module;
             }
 
-            bool evaluate(const llvm::Module &module, const boost::json::array &public_input) {
+            // Analyze the module once, so that it could be evaluated on any number of inputs
+            bool prepare(const llvm::Module &module) {
+                prepared_module = nullptr;
+                entry_point = nullptr;
                 layout_resolver = std::make_unique<LayoutResolver>(module.getDataLayout());
-                stack_frame<var> base_frame;
-                auto &variables = base_frame.scalars;
-                base_frame.caller = nullptr;
+                if (!program.decode(module)) {
+                    return false;
+                }
                 auto entry_point_it = module.end();
                 for (auto function_it = module.begin(); function_it != module.end(); ++function_it) {
                     if (function_it->hasFnAttribute(llvm::Attribute::Circuit)) {
@@ -1285,20 +1346,146 @@ namespace nil {
                     std::cerr << "Entry point is not found" << std::endl;
                     return false;
                 }
-                auto &function = *entry_point_it;
+                entry_point = &*entry_point_it;
+                entry_plan = compile_input_plan<BlueprintFieldType>(*entry_point, *layout_resolver);
+
+                // Collect all the possible labels that could be an argument in IndirectBrInst
+                indirect_targets.clear();
+                std::unordered_set<const llvm::BasicBlock *> known_targets;
+                for (const llvm::Function &function : module) {
+                    for (const llvm::BasicBlock &bb : function) {
+                        for (const llvm::Instruction &inst : bb) {
+                            if (inst.getOpcode() != llvm::Instruction::IndirectBr) {
+                                continue;
+                            }
+                            auto ib = llvm::cast<llvm::IndirectBrInst>(&inst);
+                            for (const llvm::BasicBlock *succ : ib->successors()) {
+                                if (known_targets.insert(succ).second) {
+                                    indirect_targets.push_back(succ);
+                                }
+                            }
+                        }
+                    }
+                }
+                prepared_module = &module;
+                return true;
+            }
+
+            bool evaluate(const llvm::Module &module, const boost::json::array &public_input) {
+                return evaluate_input(module, public_input);
+            }
+
+            // The input is read from the stream without building the JSON document, see InputReader
+            bool evaluate(const llvm::Module &module, json_token_stream &public_input) {
+                return evaluate_input(module, public_input);
+            }
+
+            bool evaluate(const llvm::Module &module, binary_input &public_input) {
+                return evaluate_input(module, public_input);
+            }
+
+            // Evaluate the module on every input. The tables of an input are available in circuits and assignments
+            // while the callback is called with the index of the input and the result of the evaluation
+            template<typename Callback>
+            bool evaluate_batch(const llvm::Module &module, const std::vector<boost::json::array> &public_inputs,
+                                Callback &&on_evaluated) {
+                if (!prepare(module)) {
+                    return false;
+                }
+                bool all_evaluated = true;
+                for (std::size_t i = 0; i < public_inputs.size(); i++) {
+                    bool res = evaluate(module, public_inputs[i]);
+                    on_evaluated(i, res);
+                    all_evaluated = all_evaluated && res;
+                }
+                return all_evaluated;
+            }
+
+            // Interpret the module to get the size of its tables. Witnesses of the components are generated only
+            // if the control flow depends on them, so the tables are left incomplete
+            bool estimate(const llvm::Module &module, const boost::json::array &public_input, cost_report &report) {
+                estimating = true;
+                bool res = evaluate(module, public_input);
+                estimating = false;
+                if (!res) {
+                    return false;
+                }
+
+                report.rows_amount = assignment_ptr->allocated_rows();
+                report.padded_rows_amount = 1;
+                while (report.padded_rows_amount < report.rows_amount) {
+                    report.padded_rows_amount *= 2;
+                }
+                report.public_inputs_amount = public_input_idx;
+                report.provers.clear();
+                for (std::size_t i = 0; i < assignments.size(); i++) {
+                    report.provers.push_back({assignments[i].get_used_rows().size(),
+                                              circuits[i].get_used_gates().size(),
+                                              circuits[i].get_used_copy_constraints().size()});
+                }
+                return true;
+            }
+
+            template<typename InputType>
+            var put_into_assignment(InputType input) {
+                assignments[currProverIdx].public_input(0, public_input_idx) = input;
+                set_shadow(public_shadow, public_input_idx, input);
+                return var(0, public_input_idx++, false, var::column_type::public_input);
+            }
+
+            // Values which are needed only by the interpreter, see detail::generation_context::is_host
+            template<typename InputType>
+            var put_host_value(InputType input) {
+                assignments[currProverIdx].private_storage(private_storage_idx) = input;
+                set_shadow(private_shadow, private_storage_idx, input);
+                return var(assignment_proxy<ArithmetizationType>::private_storage_index, private_storage_idx++, false,
+                           var::column_type::public_input);
+            }
+
+        private:
+            template<typename Input>
+            bool evaluate_input(const llvm::Module &module, Input &public_input) {
+                if (prepared_module != &module && !prepare(module)) {
+                    return false;
+                }
+                if (evaluated) {
+                    reset();
+                }
+                evaluated = true;
+                reset_constant_pool();
+                generation.set_mode(cached_circuit ? generation_mode::ASSIGNMENTS : generation_mode::CIRCUIT_AND_ASSIGNMENTS);
+                if (assignment_threads < 2) {
+                    assignment_pool.reset();
+                } else if (!assignment_pool || assignment_pool->size() != assignment_threads) {
+                    assignment_pool = std::make_unique<detail::assignment_thread_pool>(assignment_threads);
+                }
+                scheduler.start(assignment_ptr, assignment_pool.get(), estimating);
+                generation.scheduler = &scheduler;
+
+                const llvm::Function &function = *entry_point;
+                stack_frame<var> base_frame(program.get_numbering(function));
+                base_frame.caller = nullptr;
+                base_frame.return_idx = decoded_program::npos;
 
                 auto input_reader = InputReader<BlueprintFieldType, var, assignment_proxy<ArithmetizationType>>(
                     base_frame, stack_memory, assignments[currProverIdx], *layout_resolver);
+                input_reader.set_thread_pool(assignment_pool.get());
+                input_reader.set_plan(entry_plan);
+                input_error.clear();
                 if (!input_reader.fill_public_input(function, public_input)) {
+                    input_error = input_reader.get_error();
                     std::cerr << "Public input does not match the circuit signature";
-                    const std::string &error = input_reader.get_error();
-                    if (!error.empty()) {
-                        std::cout << ": " << error;
+                    if (!input_error.empty()) {
+                        std::cout << ": " << input_error;
                     }
                     std::cout << std::endl;
                     return false;
                 }
                 public_input_idx = input_reader.get_idx();
+                private_storage_idx = input_reader.get_private_idx();
+                materialized_host_values.clear();
+                generation.start_host_values(private_storage_idx,
+                                             [this](const var &v) { return materialize_host_value(v); });
                 call_stack.emplace(std::move(base_frame));
 
                 for (const llvm::GlobalVariable &global : module.getGlobalList()) {
@@ -1306,80 +1493,187 @@ namespace nil {
                     const llvm::Constant *initializer = global.getInitializer();
                     if (initializer->getType()->isAggregateType()) {
                         ptr_type ptr = store_constant<var>(initializer);
-                        globals[&global] = put_into_assignment(ptr);
+                        globals[&global] = put_host_value(ptr);
                     } else if (initializer->getType()->isIntegerTy() ||
                         (initializer->getType()->isFieldTy() && field_arg_num<BlueprintFieldType>(initializer->getType()) == 1)) {
                         ptr_type ptr = stack_memory.add_cells({layout_resolver->get_type_size(initializer->getType())});
                         std::vector<typename BlueprintFieldType::value_type> marshalled_field_val = marshal_field_val<BlueprintFieldType>(initializer);
                         stack_memory.store(ptr, put_into_assignment(marshalled_field_val[0]));
-                        globals[&global] = put_into_assignment(ptr);
+                        globals[&global] = put_host_value(ptr);
                     } else if (llvm::isa<llvm::ConstantPointerNull>(initializer)) {
                         ptr_type ptr = stack_memory.add_cells({layout_resolver->get_type_size(initializer->getType())});
                         stack_memory.store(ptr, zero_var);
-                        globals[&global] = put_into_assignment(ptr);
+                        globals[&global] = put_host_value(ptr);
                     } else {
                         UNREACHABLE("Unhandled global variable");
                     }
                 }
 
-                // Collect all the possible labels that could be an argument in IndirectBrInst
-                for (const llvm::Function &function : module) {
-                    for (const llvm::BasicBlock &bb : function) {
-                        for (const llvm::Instruction &inst : bb) {
-                            if (inst.getOpcode() != llvm::Instruction::IndirectBr) {
-                                continue;
-                            }
-                            auto ib = llvm::cast<llvm::IndirectBrInst>(&inst);
-                            for (const llvm::BasicBlock *succ : ib->successors()) {
-                                if (labels.find(succ) != labels.end()) {
-                                    continue;
-                                }
-                                auto label_type = llvm::Type::getInt8PtrTy(module.getContext());
-                                unsigned label_type_size = layout_resolver->get_type_size(label_type);
-                                ptr_type ptr = stack_memory.add_cells({label_type_size});
+                if (!indirect_targets.empty()) {
+                    auto label_type = llvm::Type::getInt8PtrTy(module.getContext());
+                    unsigned label_type_size = layout_resolver->get_type_size(label_type);
+                    for (const llvm::BasicBlock *succ : indirect_targets) {
+                        ptr_type ptr = stack_memory.add_cells({label_type_size});
 
-                                // Store the pointer to BasicBlock to memory
-                                // TODO(maksenov): avoid C++ pointers in assignment table
-                                stack_memory.store(ptr, put_into_assignment((const uintptr_t)succ));
+                        // Store the pointer to BasicBlock to memory
+                        // TODO(maksenov): avoid C++ pointers in assignment table
+                        stack_memory.store(ptr, put_host_value((const uintptr_t)succ));
 
-                                labels[succ] = put_into_assignment(ptr);
-                            }
-                        }
+                        labels[succ] = put_host_value(ptr);
                     }
                 }
 
                 // Initialize undef and zero vars once
                 undef_var = put_into_assignment(typename BlueprintFieldType::value_type());
-                zero_var = put_into_assignment(typename BlueprintFieldType::value_type(0));
+                zero_var = put_constant_value(typename BlueprintFieldType::value_type(0));
 
-                const llvm::Instruction *next_inst = &function.begin()->front();
+                std::size_t next_idx = program.get_entry(function);
                 while (true) {
-                    next_inst = handle_instruction(next_inst);
+                    next_idx = handle_instruction(program[next_idx]);
                     if (finished) {
-                        return true;
+                        return finish_generation();
                     }
-                    if (next_inst == nullptr) {
+                    if (next_idx == decoded_program::npos) {
                         return false;
                     }
                 }
             }
 
+            // Native copy of a cell written by the interpreter, if its value fits into a machine word.
+            // Addresses, offsets and indices are resolved from it without field element conversions
+            struct shadow_entry {
+                std::uint64_t value;
+                bool valid;
+            };
+
             template<typename InputType>
-            var put_into_assignment(InputType input) {
-                assignments[currProverIdx].public_input(0, public_input_idx) = input;
-                return var(0, public_input_idx++, false, var::column_type::public_input);
+            static void set_shadow(std::vector<shadow_entry> &shadow, std::size_t idx, const InputType &input) {
+                if (shadow.size() <= idx) {
+                    shadow.resize(idx + 1, {0, false});
+                }
+                if constexpr (std::is_integral_v<InputType>) {
+                    shadow[idx] = {static_cast<std::uint64_t>(input), !std::is_signed_v<InputType> || input >= 0};
+                } else {
+                    static const typename BlueprintFieldType::integral_type word_limit =
+                        typename BlueprintFieldType::integral_type(std::numeric_limits<std::uint64_t>::max());
+                    auto integral_value = static_cast<typename BlueprintFieldType::integral_type>(input.data);
+                    if (integral_value <= word_limit) {
+                        shadow[idx] = {static_cast<std::uint64_t>(integral_value), true};
+                    } else {
+                        shadow[idx] = {0, false};
+                    }
+                }
+            }
+
+            const shadow_entry *find_shadow(const var &v) const {
+                if (v.type != var::column_type::public_input) {
+                    return nullptr;
+                }
+                const std::vector<shadow_entry> *shadow = nullptr;
+                if (v.index == 0) {
+                    shadow = &public_shadow;
+                } else if (v.index == assignment_proxy<ArithmetizationType>::private_storage_index) {
+                    shadow = &private_shadow;
+                } else {
+                    return nullptr;
+                }
+                std::size_t idx = v.rotation;
+                if (idx >= shadow->size() || !(*shadow)[idx].valid) {
+                    return nullptr;
+                }
+                return &(*shadow)[idx];
+            }
+
+            var materialize_host_value(const var &v) {
+                if (materialized_prover != currProverIdx) {
+                    materialized_host_values.clear();
+                    materialized_prover = currProverIdx;
+                }
+                auto it = materialized_host_values.find(v.rotation);
+                if (it != materialized_host_values.end()) {
+                    return it->second;
+                }
+                var res = put_into_assignment(var_value(assignments[currProverIdx], v));
+                materialized_host_values.emplace(v.rotation, res);
+                return res;
+            }
+
+            // Drop everything left from the previous evaluation, the new input gets fresh tables
+            void reset() {
+                while (!call_stack.empty()) {
+                    call_stack.pop();
+                }
+                stack_memory.reset();
+                globals.clear();
+                labels.clear();
+                predecessor = nullptr;
+                finished = false;
+                public_input_idx = 0;
+                private_storage_idx = 0;
+                public_shadow.clear();
+                private_shadow.clear();
+                currProverIdx = 0;
+                materialized_prover = 0;
+
+                assignment_ptr = std::make_shared<assignment<ArithmetizationType>>();
+                bp_ptr = cached_circuit ? cached_circuit->bp : std::make_shared<circuit<ArithmetizationType>>();
+                assignments.clear();
+                circuits.clear();
+                assignments.emplace_back(assignment_ptr, currProverIdx);
+                circuits.emplace_back(bp_ptr, currProverIdx);
+            }
+
+            bool finish_generation() {
+                if (estimating) {
+                    scheduler.discard(assignments);
+                } else {
+                    scheduler.flush(assignments);
+                }
+                circuit_fingerprint = generation.get_fingerprint();
+                if (!cached_circuit) {
+                    return true;
+                }
+                if (circuit_fingerprint != cached_circuit->fingerprint ||
+                    assignment_ptr->allocated_rows() != cached_circuit->rows_amount) {
+                    std::cerr << "Control flow does not match the cached circuit" << std::endl;
+                    return false;
+                }
+                detail::copy_circuit_columns(*cached_circuit->table, *assignment_ptr);
+                return true;
             }
 
-        private:
             llvm::LLVMContext context;
             const llvm::BasicBlock *predecessor = nullptr;
             std::stack<stack_frame<var>> call_stack;
             program_memory<var> stack_memory;
             std::unordered_map<const llvm::Value *, var> globals;
             std::unordered_map<const llvm::BasicBlock *, var> labels;
+            std::unordered_map<const llvm::Constant *, std::vector<var>> constant_pool;
+            std::map<typename BlueprintFieldType::integral_type, var> constant_values;
+            std::uint32_t constant_pool_prover = 0;
             bool finished = false;
+            bool evaluated = false;
+            const llvm::Module *prepared_module = nullptr;
+            const llvm::Function *entry_point = nullptr;
+            std::vector<const llvm::BasicBlock *> indirect_targets;
             size_t public_input_idx = 0;
+            size_t private_storage_idx = 0;
+            std::unordered_map<std::size_t, var> materialized_host_values;
+            std::uint32_t materialized_prover = 0;
+            std::vector<shadow_entry> public_shadow;
+            std::vector<shadow_entry> private_shadow;
             std::unique_ptr<LayoutResolver> layout_resolver;
+            decoded_program program;
+            std::optional<circuit_template<ArithmetizationType>> cached_circuit;
+            std::size_t circuit_fingerprint = 0;
+            input_plan entry_plan;
+            std::string input_error;
+            std::size_t assignment_threads = 0;
+            std::unique_ptr<detail::assignment_thread_pool> assignment_pool;
+            detail::AssignmentScheduler<ArithmetizationType> scheduler;
+            detail::generation_context<ArithmetizationType> generation;
+            bool pre_optimization = false;
+            bool estimating = false;
             var undef_var;
             var zero_var;
             logger log;
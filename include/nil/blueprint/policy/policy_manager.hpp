@@ -27,6 +27,10 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <tuple>
+#include <typeindex>
+#include <unordered_map>
 
 #include <nil/blueprint/policy/default_policy.hpp>
 
@@ -48,12 +52,17 @@ namespace nil {
                 }
 
                 static void set_policy(policy_kind kind) {
+                    if (policy && kind == current_kind) {
+                        return;
+                    }
                     switch (kind) {
                         case policy_kind::DEFAULT:
                         default: {
                             policy.reset(new DefaultPolicy());
                         }
                     }
+                    current_kind = kind;
+                    ++generation;
                 }
 
                 static void set_policy(const std::string &kind_str) {
@@ -62,13 +71,61 @@ namespace nil {
                         set_policy(it->second);
                     }
                 }
+                // Changes every time the policy is set, so the parameters chosen by the previous policy can be dropped
+                static std::size_t get_generation() {
+                    return generation;
+                }
             private:
                 inline static std::shared_ptr <Policy> policy = nullptr;
+                inline static policy_kind current_kind = policy_kind::DEFAULT;
+                inline static std::size_t generation = 0;
 
                 inline static const std::map<std::string, policy_kind> policy_kind_map = {
                         {"default", policy_kind::DEFAULT}
                 };
             };
+
+            // Component instances of one parser, see ComponentCache
+            class component_instances {
+                template<typename ComponentType, typename ArithmetizationParams>
+                friend struct ComponentCache;
+
+                std::unordered_map<std::type_index, std::shared_ptr<void>> instances;
+                std::size_t generation = PolicyManager::get_generation();
+            };
+
+            // A component is fully defined by the manifest arguments, the constructor arguments and the policy.
+            // Instances are built once and reused by all the handler calls of the parser with the same arguments
+            template<typename ComponentType, typename ArithmetizationParams>
+            struct ComponentCache {
+                template<typename... ManifestArgs, typename... Args>
+                static const ComponentType &get(component_instances &cache,
+                                                const std::tuple<ManifestArgs...> &manifest_args, Args... args) {
+                    using reader_type = ManifestReader<ComponentType, ArithmetizationParams>;
+                    using key_type = std::pair<std::tuple<ManifestArgs...>, std::tuple<Args...>>;
+                    using instances_type = std::map<key_type, ComponentType>;
+
+                    if (cache.generation != PolicyManager::get_generation()) {
+                        cache.instances.clear();
+                        cache.generation = PolicyManager::get_generation();
+                    }
+                    std::shared_ptr<void> &entry = cache.instances[std::type_index(typeid(instances_type))];
+                    if (!entry) {
+                        entry = std::make_shared<instances_type>();
+                    }
+                    instances_type &instances = *static_cast<instances_type *>(entry.get());
+
+                    key_type key(manifest_args, std::make_tuple(args...));
+                    auto it = instances.find(key);
+                    if (it == instances.end()) {
+                        const auto p = PolicyManager::get_parameters(std::apply(
+                            [](auto... witness_args) { return reader_type::get_witness(witness_args...); }, manifest_args));
+                        it = instances.emplace(key, ComponentType(p.witness, reader_type::get_constants(),
+                                                                  reader_type::get_public_inputs(), args...)).first;
+                    }
+                    return it->second;
+                }
+            };
         }    // namespace detail
     }    // namespace blueprint
 }    // namespace nil
@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_PRE_OPTIMIZATION_HPP
+#define CRYPTO3_ASSIGNER_PRE_OPTIMIZATION_HPP
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Transforms/Scalar/EarlyCSE.h"
+#include "llvm/Transforms/Utils/Mem2Reg.h"
+
+namespace nil {
+    namespace blueprint {
+        namespace detail {
+            // Instructions of a function run on the prover chosen by the zk_multi_prover annotations
+            // of the function, or on the one of the caller
+            inline bool has_prover_annotations(const llvm::Function &function) {
+                for (const llvm::Instruction &inst : llvm::instructions(function)) {
+                    if (inst.getMetadata("zk_multi_prover") != nullptr) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        }    // namespace detail
+
+        // Removes alloca/load/store round trips and repeated computations before the interpretation.
+        // Only the passes which move values around without rewriting the arithmetic are used,
+        // so field and curve operations reach the interpreter unchanged. InstCombine is left out
+        // on purpose: it turns arithmetic into shifts, masks and selects, which are much more
+        // expensive in the circuit than the original operations. SROA is left out as well: splitting
+        // aggregates produces shifts, truncations and bitcasts the interpreter does not support.
+        // Functions with prover annotations are kept as written: the passes could drop an annotated
+        // instruction or replace a value with an equal one computed by another prover. Other functions
+        // run entirely on a single prover, so their values can be merged. Constant GEPs may be folded
+        // into constant expressions, the interpreter evaluates them like the instructions
+        inline void run_pre_optimization(llvm::Module &module) {
+            llvm::LoopAnalysisManager loop_analyses;
+            llvm::FunctionAnalysisManager function_analyses;
+            llvm::CGSCCAnalysisManager cgscc_analyses;
+            llvm::ModuleAnalysisManager module_analyses;
+
+            llvm::PassBuilder pass_builder;
+            pass_builder.registerModuleAnalyses(module_analyses);
+            pass_builder.registerCGSCCAnalyses(cgscc_analyses);
+            pass_builder.registerFunctionAnalyses(function_analyses);
+            pass_builder.registerLoopAnalyses(loop_analyses);
+            pass_builder.crossRegisterProxies(loop_analyses, function_analyses, cgscc_analyses, module_analyses);
+
+            // Both passes keep the CFG, so the decoded block layout stays as written
+            llvm::FunctionPassManager function_passes;
+            function_passes.addPass(llvm::PromotePass());
+            function_passes.addPass(llvm::EarlyCSEPass());
+
+            for (llvm::Function &function : module) {
+                if (function.isDeclaration() || detail::has_prover_annotations(function)) {
+                    continue;
+                }
+                function_passes.run(function, function_analyses);
+            }
+        }
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_PRE_OPTIMIZATION_HPP
@@ -26,8 +26,9 @@
 #ifndef CRYPTO3_ASSIGNER_STACK_HPP
 #define CRYPTO3_ASSIGNER_STACK_HPP
 
+#include <limits>
 #include <list>
-#include <map>
+#include <unordered_map>
 #include <variant>
 #include <stack>
 
@@ -39,16 +40,102 @@
 #include <llvm/IR/Instructions.h>
 #include "llvm/IR/Constants.h"
 
+#include <nil/blueprint/asserts.hpp>
 #include <nil/blueprint/memory.hpp>
 
 namespace nil {
     namespace blueprint {
 
+        class decoded_program;
+
+        // Dense numbering of the values which may be stored in a function frame.
+        // It is computed once per function by decoded_program and is immutable afterwards,
+        // frames then keep values in flat vectors indexed by slot
+        class value_numbering {
+        public:
+            static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+            std::uint32_t slot(const llvm::Value *value) const {
+                std::uint32_t res = find_slot(value);
+                ASSERT_MSG(res != npos, "Value has no slot");
+                return res;
+            }
+
+            std::uint32_t find_slot(const llvm::Value *value) const {
+                auto it = slots.find(value);
+                if (it == slots.end()) {
+                    return npos;
+                }
+                return it->second;
+            }
+
+            std::uint32_t size() const {
+                return slots.size();
+            }
+
+        private:
+            friend class decoded_program;
+
+            std::uint32_t add(const llvm::Value *value) {
+                return slots.emplace(value, slots.size()).first->second;
+            }
+
+            std::unordered_map<const llvm::Value *, std::uint32_t> slots;
+        };
+
+        // Register file of a frame. Like std::map::operator[], accessing a value marks it as present
+        template<typename ValueType>
+        class value_storage {
+            struct entry {
+                ValueType value;
+                bool assigned = false;
+            };
+
+        public:
+            value_storage(const value_numbering &numbering) : numbering(&numbering), entries(numbering.size()) {}
+
+            ValueType &operator[](const llvm::Value *value) {
+                return at_slot(numbering->slot(value));
+            }
+
+            ValueType &at_slot(std::uint32_t slot) {
+                ASSERT_MSG(slot < entries.size(), "Value has no slot");
+                entries[slot].assigned = true;
+                return entries[slot].value;
+            }
+
+            const ValueType &at_slot(std::uint32_t slot) const {
+                ASSERT(contains_slot(slot));
+                return entries[slot].value;
+            }
+
+            bool contains(const llvm::Value *value) const {
+                return contains_slot(numbering->find_slot(value));
+            }
+
+            bool contains_slot(std::uint32_t slot) const {
+                return slot < entries.size() && entries[slot].assigned;
+            }
+
+        private:
+            const value_numbering *numbering;
+            std::vector<entry> entries;
+        };
+
         template<typename VarType>
         struct stack_frame {
-            std::map<const llvm::Value *, VarType> scalars;
-            std::map<const llvm::Value *, std::vector<VarType>> vectors;
+            stack_frame(const value_numbering &numbering) :
+                numbering(&numbering), scalars(numbering), vectors(numbering),
+                caller(nullptr), return_idx(0), return_slot(value_numbering::npos) {}
+
+            const value_numbering *numbering;
+            value_storage<VarType> scalars;
+            value_storage<std::vector<VarType>> vectors;
             const llvm::CallInst *caller;
+            // Index of the instruction the caller is resumed from
+            std::size_t return_idx;
+            // Slot of the call instruction in the caller frame
+            std::uint32_t return_slot;
         };
 
     }    // namespace blueprint
@@ -0,0 +1,144 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_daemon_test
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <boost/json.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <nil/blueprint/assigner_daemon.hpp>
+#include <nil/blueprint/test/tables.hpp>
+
+using namespace nil::blueprint;
+
+namespace {
+    using daemon_type = assigner_daemon<test::field_type, test::arithmetization_params>;
+
+    int connect_to(const std::string &socket_path) {
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        std::copy(socket_path.begin(), socket_path.end(), address.sun_path);
+        // The daemon may not be listening yet
+        for (int attempt = 0; attempt < 500; attempt++) {
+            int connection = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (connection < 0) {
+                return -1;
+            }
+            if (::connect(connection, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0) {
+                return connection;
+            }
+            ::close(connection);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return -1;
+    }
+
+    boost::json::object round_trip(int connection, const std::string &request) {
+        std::string line = request + "\n";
+        BOOST_REQUIRE_EQUAL(::write(connection, line.data(), line.size()), ssize_t(line.size()));
+        std::string response;
+        char c;
+        while (::read(connection, &c, 1) == 1 && c != '\n') {
+            response.push_back(c);
+        }
+        boost::json::value value = boost::json::parse(response);
+        BOOST_REQUIRE(value.is_object());
+        return value.as_object();
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(assigner_daemon_test_suite)
+
+BOOST_AUTO_TEST_CASE(socket_round_trip) {
+    const std::string ir_file = test::data_path("pallas_native_field_add.ll");
+    const std::string input = R"([{"field": 10}, {"field": 20}])";
+
+    test::assigner_type expected_assigner(test::stack_size, false, 1);
+    auto expected_module = expected_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(expected_module != nullptr);
+    BOOST_REQUIRE(expected_assigner.evaluate(*expected_module, boost::json::parse(input).as_array()));
+
+    // Requests are served one by one, the test reads the template only after the response
+    circuit_template<test::arithmetization_type> served;
+    daemon_type daemon(test::stack_size, 1, "",
+                       [&served](const daemon_type::parser_type &assigner, const std::string &output_prefix,
+                                 std::vector<std::string> &files, std::string &) {
+                           served = assigner.get_circuit_template();
+                           files.push_back(output_prefix + ".tbl");
+                           return true;
+                       });
+    BOOST_REQUIRE(daemon.load("field_add", ir_file.c_str()));
+
+    const std::string socket_path = "/tmp/assigner_daemon_test_" + std::to_string(::getpid()) + ".sock";
+    std::thread server([&daemon, &socket_path]() { daemon.serve(socket_path); });
+    int connection = connect_to(socket_path);
+    BOOST_REQUIRE(connection >= 0);
+
+    boost::json::object response =
+        round_trip(connection, R"({"circuit": "field_add", "input": )" + input + R"(, "output": "add"})");
+    BOOST_CHECK_EQUAL(response["status"].as_string(), "ok");
+    BOOST_CHECK_EQUAL(response["files"].as_array().at(0).as_string(), "add.tbl");
+    test::check_equal_tables(expected_assigner.get_circuit_template(), served);
+
+    response = round_trip(connection, R"({"circuit": "field_add", "input": )");
+    BOOST_CHECK_EQUAL(response["status"].as_string(), "error");
+    BOOST_CHECK_EQUAL(response["error"].as_string(), "Request must be a JSON object");
+
+    response = round_trip(connection, R"({"circuit": "field_add", "input": [{"field": 10}]})");
+    BOOST_CHECK_EQUAL(response["status"].as_string(), "error");
+    BOOST_CHECK_EQUAL(response["error"].as_string().find("Public input does not match the circuit signature"), std::size_t(0));
+
+    response = round_trip(connection, R"({"circuit": "field_mul", "input": )" + input + "}");
+    BOOST_CHECK_EQUAL(response["status"].as_string(), "error");
+
+    // The daemon keeps serving after the rejected requests
+    served = {};
+    response = round_trip(connection, R"({"circuit": "field_add", "input": )" + input + R"(, "output": "again"})");
+    BOOST_CHECK_EQUAL(response["status"].as_string(), "ok");
+    test::check_equal_tables(expected_assigner.get_circuit_template(), served);
+
+    daemon.stop();
+    ::close(connection);
+    server.join();
+}
+
+BOOST_AUTO_TEST_CASE(recoverable_assertion) {
+    {
+        recoverable_assertions recoverable;
+        BOOST_CHECK_THROW(ASSERT_MSG(false, "failed on purpose"), assertion_failure);
+    }
+    BOOST_CHECK(!recoverable_assertions::active());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
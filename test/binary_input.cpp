@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_binary_input_test
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <nil/blueprint/binary_input.hpp>
+#include <nil/blueprint/test/tables.hpp>
+
+using namespace nil::blueprint;
+
+namespace {
+    void put_word(std::vector<std::uint8_t> &buffer, std::uint64_t word) {
+        for (std::size_t i = 0; i < 8; i++) {
+            buffer.push_back(std::uint8_t(word >> (8 * i)));
+        }
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(assigner_binary_input_test_suite)
+
+BOOST_AUTO_TEST_CASE(aggregate_arguments_match_json) {
+    const std::string ir_file = test::data_path("aggregate_arguments.ll");
+
+    test::assigner_type json_assigner(test::stack_size, false, 1);
+    auto json_module = json_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(json_module != nullptr);
+    boost::json::array json_input = boost::json::parse(
+        R"([{"array": [{"int": 1}, {"int": 2}, {"int": 3}]}, {"struct": [{"int": 4}, {"int": 5}]}, {"int": 6}])")
+        .as_array();
+    BOOST_REQUIRE(json_assigner.evaluate(*json_module, json_input));
+
+    std::vector<std::uint8_t> buffer(std::begin(binary_input::magic), std::end(binary_input::magic));
+    put_word(buffer, 3);
+    for (std::uint64_t word : {3, 1, 2, 3, 2, 4, 5, 6}) {
+        put_word(buffer, word);
+    }
+    binary_input input(buffer.data(), buffer.size());
+
+    test::assigner_type binary_assigner(test::stack_size, false, 1);
+    auto binary_module = binary_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(binary_module != nullptr);
+    BOOST_REQUIRE(binary_assigner.evaluate(*binary_module, input));
+
+    test::check_equal_tables(json_assigner.get_circuit_template(), binary_assigner.get_circuit_template());
+}
+
+BOOST_AUTO_TEST_CASE(truncated_input_is_rejected) {
+    std::vector<std::uint8_t> buffer(std::begin(binary_input::magic), std::end(binary_input::magic));
+    put_word(buffer, 3);
+    for (std::uint64_t word : {3, 1, 2, 3, 2, 4}) {
+        put_word(buffer, word);
+    }
+    binary_input input(buffer.data(), buffer.size());
+
+    test::assigner_type assigner(test::stack_size, false, 1);
+    auto module = assigner.parseIRFile(test::data_path("aggregate_arguments.ll").c_str());
+    BOOST_REQUIRE(module != nullptr);
+    BOOST_CHECK(!assigner.evaluate(*module, input));
+    BOOST_CHECK_EQUAL(assigner.get_input_error(), "unexpected end of the binary input");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
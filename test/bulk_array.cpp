@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_bulk_array_test
+
+#include <string>
+
+#include <boost/json.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <nil/blueprint/test/circuit_output.hpp>
+
+using namespace nil::blueprint;
+
+namespace {
+    // {"array": [{"int": "0"}, {"int": 1}, ...]}, every other element is a string
+    std::string bulk_array_input(std::size_t elements_amount) {
+        std::string res = "[{\"array\": [";
+        for (std::size_t i = 0; i < elements_amount; i++) {
+            if (i != 0) {
+                res += ", ";
+            }
+            res += i % 2 == 0 ? "{\"int\": \"" + std::to_string(i) + "\"}" : "{\"int\": " + std::to_string(i) + "}";
+        }
+        return res + "]}]";
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(assigner_bulk_array_test_suite)
+
+BOOST_AUTO_TEST_CASE(bulk_array_is_decoded) {
+    test::printing_assigner_type assigner(test::stack_size, false, 1);
+    auto module = assigner.parseIRFile(test::data_path("bulk_array.ll").c_str());
+    BOOST_REQUIRE(module != nullptr);
+    boost::json::array input = boost::json::parse(bulk_array_input(5000)).as_array();
+
+    std::string output;
+    {
+        test::output_capture capture;
+        BOOST_REQUIRE(assigner.evaluate(*module, input));
+        output = capture.str();
+    }
+    BOOST_CHECK_EQUAL(output, "4999\n");
+}
+
+// The chunks of a bulk array are decoded on the pool, the table must not depend on it
+BOOST_AUTO_TEST_CASE(pool_decoding_matches_sequential) {
+    const std::string ir_file = test::data_path("bulk_array.ll");
+
+    test::assigner_type sequential_assigner(test::stack_size, false, 1);
+    auto sequential_module = sequential_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(sequential_module != nullptr);
+    boost::json::array input = boost::json::parse(bulk_array_input(5000)).as_array();
+    BOOST_REQUIRE(sequential_assigner.evaluate(*sequential_module, input));
+
+    test::assigner_type pool_assigner(test::stack_size, false, 1);
+    pool_assigner.set_assignment_threads(4);
+    auto pool_module = pool_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(pool_module != nullptr);
+    BOOST_REQUIRE(pool_assigner.evaluate(*pool_module, input));
+
+    test::check_equal_tables(sequential_assigner.get_circuit_template(), pool_assigner.get_circuit_template());
+}
+
+BOOST_AUTO_TEST_CASE(short_bulk_array_is_rejected) {
+    test::assigner_type assigner(test::stack_size, false, 1);
+    auto module = assigner.parseIRFile(test::data_path("bulk_array.ll").c_str());
+    BOOST_REQUIRE(module != nullptr);
+    boost::json::array input = boost::json::parse(bulk_array_input(4999)).as_array();
+    BOOST_CHECK(!assigner.evaluate(*module, input));
+    BOOST_CHECK(!assigner.get_input_error().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
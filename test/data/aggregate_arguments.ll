@@ -0,0 +1,26 @@
+target datalayout = "e-m:e-p:64:64-i64:64-i128:128-n32:64-S128"
+target triple = "assigner"
+
+%struct.pair = type { i64, i64 }
+
+; Function Attrs: circuit mustprogress nounwind
+define dso_local noundef i64 @aggregate_arguments(ptr noundef byval([3 x i64]) align 8 %arr, ptr noundef byval(%struct.pair) align 8 %p, i64 noundef %x) local_unnamed_addr #0 {
+entry:
+  %last.ptr = getelementptr inbounds [3 x i64], ptr %arr, i64 0, i64 2
+  %last = load i64, ptr %last.ptr, align 8
+  %second.ptr = getelementptr inbounds %struct.pair, ptr %p, i64 0, i32 1
+  %second = load i64, ptr %second.ptr, align 8
+  %add = add i64 %last, %second
+  %res = add i64 %add, %x
+  ret i64 %res
+}
+
+attributes #0 = { circuit mustprogress nounwind "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" }
+
+!llvm.linker.options = !{}
+!llvm.module.flags = !{!0, !1}
+!llvm.ident = !{!2}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 7, !"frame-pointer", i32 2}
+!2 = !{!"clang version 16.0.0 (git@github.com:NilFoundation/zkllvm-circifier.git 8d79290301f85623f70c3b4ee874ac5687ef78ed)"}
@@ -0,0 +1,22 @@
+target datalayout = "e-m:e-p:64:64-i64:64-i128:128-n32:64-S128"
+target triple = "assigner"
+
+; Function Attrs: circuit mustprogress nounwind
+define dso_local noundef i64 @bulk_array(ptr noundef byval([5000 x i64]) align 8 %arr) local_unnamed_addr #0 {
+entry:
+  %first = load i64, ptr %arr, align 8
+  %last.ptr = getelementptr inbounds [5000 x i64], ptr %arr, i64 0, i64 4999
+  %last = load i64, ptr %last.ptr, align 8
+  %add = add i64 %first, %last
+  ret i64 %add
+}
+
+attributes #0 = { circuit mustprogress nounwind "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" }
+
+!llvm.linker.options = !{}
+!llvm.module.flags = !{!0, !1}
+!llvm.ident = !{!2}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 7, !"frame-pointer", i32 2}
+!2 = !{!"clang version 16.0.0 (git@github.com:NilFoundation/zkllvm-circifier.git 8d79290301f85623f70c3b4ee874ac5687ef78ed)"}
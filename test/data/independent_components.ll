@@ -0,0 +1,26 @@
+target datalayout = "e-m:e-p:64:64-i64:64-i128:128-n32:64-S128"
+target triple = "assigner"
+
+; Function Attrs: circuit mustprogress nounwind
+define dso_local noundef __zkllvm_field_pallas_base @_Z22independent_componentsu26__zkllvm_field_pallas_baseu26__zkllvm_field_pallas_baseu26__zkllvm_field_pallas_base(__zkllvm_field_pallas_base noundef %a, __zkllvm_field_pallas_base noundef %b, __zkllvm_field_pallas_base noundef %c) local_unnamed_addr #0 {
+entry:
+  %ab = mul __zkllvm_field_pallas_base %a, %b
+  %bc = mul __zkllvm_field_pallas_base %b, %c
+  %ac = mul __zkllvm_field_pallas_base %a, %c
+  %a2 = add __zkllvm_field_pallas_base %a, %a
+  %sum = add __zkllvm_field_pallas_base %ab, %bc
+  %sum2 = add __zkllvm_field_pallas_base %sum, %ac
+  %diff = sub __zkllvm_field_pallas_base %sum2, %a2
+  %res = mul __zkllvm_field_pallas_base %diff, %c
+  ret __zkllvm_field_pallas_base %res
+}
+
+attributes #0 = { circuit mustprogress nounwind "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" }
+
+!llvm.linker.options = !{}
+!llvm.module.flags = !{!0, !1}
+!llvm.ident = !{!2}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 7, !"frame-pointer", i32 2}
+!2 = !{!"clang version 16.0.0 (git@github.com:NilFoundation/zkllvm-circifier.git 8d79290301f85623f70c3b4ee874ac5687ef78ed)"}
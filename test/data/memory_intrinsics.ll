@@ -0,0 +1,45 @@
+target datalayout = "e-m:e-p:64:64-i64:64-i128:128-n32:64-S128"
+target triple = "assigner"
+
+; Function Attrs: circuit mustprogress nounwind
+define dso_local noundef i32 @_Z17memory_intrinsicsii(i32 noundef %a, i32 noundef %b) local_unnamed_addr #0 {
+entry:
+  %src = alloca [4 x i32], align 4
+  %bytes = alloca [16 x i8], align 4
+  %dst = alloca [4 x i32], align 4
+  store i32 %a, ptr %src, align 4
+  %src1 = getelementptr inbounds [4 x i32], ptr %src, i64 0, i64 1
+  store i32 %b, ptr %src1, align 4
+  %src2 = getelementptr inbounds [4 x i32], ptr %src, i64 0, i64 2
+  store i32 %a, ptr %src2, align 4
+  %src3 = getelementptr inbounds [4 x i32], ptr %src, i64 0, i64 3
+  store i32 %b, ptr %src3, align 4
+  call void @llvm.memcpy.p0.p0.i64(ptr noundef nonnull align 4 %bytes, ptr noundef nonnull align 4 %src, i64 16, i1 false)
+  call void @llvm.memcpy.p0.p0.i64(ptr noundef nonnull align 4 %dst, ptr noundef nonnull align 4 %bytes, i64 16, i1 false)
+  %dst1 = getelementptr inbounds [4 x i32], ptr %dst, i64 0, i64 1
+  call void @llvm.memmove.p0.p0.i64(ptr noundef nonnull align 4 %dst1, ptr noundef nonnull align 4 %dst, i64 12, i1 false)
+  call void @llvm.memset.p0.i64(ptr noundef nonnull align 4 %src, i8 1, i64 4, i1 false)
+  %dst2 = getelementptr inbounds [4 x i32], ptr %dst, i64 0, i64 2
+  %dst3 = getelementptr inbounds [4 x i32], ptr %dst, i64 0, i64 3
+  %x = load i32, ptr %dst2, align 4
+  %y = load i32, ptr %dst3, align 4
+  %z = load i32, ptr %src, align 4
+  %add = add i32 %x, %y
+  %add1 = add i32 %add, %z
+  ret i32 %add1
+}
+
+declare void @llvm.memcpy.p0.p0.i64(ptr noalias nocapture writeonly, ptr noalias nocapture readonly, i64, i1 immarg) #1
+declare void @llvm.memmove.p0.p0.i64(ptr nocapture writeonly, ptr nocapture readonly, i64, i1 immarg) #1
+declare void @llvm.memset.p0.i64(ptr nocapture writeonly, i8, i64, i1 immarg) #1
+
+attributes #0 = { circuit mustprogress nounwind "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" }
+attributes #1 = { nocallback nofree nounwind willreturn memory(argmem: readwrite) }
+
+!llvm.linker.options = !{}
+!llvm.module.flags = !{!0, !1}
+!llvm.ident = !{!2}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 7, !"frame-pointer", i32 2}
+!2 = !{!"clang version 16.0.0 (git@github.com:NilFoundation/zkllvm-circifier.git 8d79290301f85623f70c3b4ee874ac5687ef78ed)"}
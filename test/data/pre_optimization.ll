@@ -0,0 +1,43 @@
+target datalayout = "e-m:e-p:64:64-i64:64-i128:128-n32:64-S128"
+target triple = "assigner"
+
+@values = dso_local global [3 x i64] [i64 3, i64 5, i64 7], align 8
+
+; Function Attrs: mustprogress noinline nounwind
+define dso_local noundef i64 @_Z6middlev() #1 {
+entry:
+  %slot = alloca i64, align 8
+  %second = getelementptr inbounds [3 x i64], ptr @values, i64 0, i64 1
+  %value = load i64, ptr %second, align 8
+  store i64 %value, ptr %slot, align 8
+  %copy = load i64, ptr %slot, align 8
+  ret i64 %copy
+}
+
+; Function Attrs: circuit mustprogress nounwind
+define dso_local noundef i64 @_Z16pre_optimizationll(i64 noundef %a, i64 noundef %b) local_unnamed_addr #0 {
+entry:
+  %m = call noundef i64 @_Z6middlev()
+  %last = getelementptr inbounds [3 x i64], ptr @values, i64 0, i64 2
+  %l = load i64, ptr %last, align 8
+  %x = add i64 %a, %b
+  %y = add i64 %x, %m, !zk_multi_prover !3
+  %w = add i64 %y, %l
+  %z = add i64 %w, 1, !zk_multi_prover !4
+  %x2 = add i64 %a, %b
+  %res = add i64 %z, %x2
+  ret i64 %res
+}
+
+attributes #0 = { circuit mustprogress nounwind "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" }
+attributes #1 = { mustprogress noinline nounwind "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" }
+
+!llvm.linker.options = !{}
+!llvm.module.flags = !{!0, !1}
+!llvm.ident = !{!2}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 7, !"frame-pointer", i32 2}
+!2 = !{!"clang version 16.0.0 (git@github.com:NilFoundation/zkllvm-circifier.git 8d79290301f85623f70c3b4ee874ac5687ef78ed)"}
+!3 = !{!"0"}
+!4 = !{!"1"}
@@ -0,0 +1,20 @@
+target datalayout = "e-m:e-p:64:64-i64:64-i128:128-n32:64-S128"
+target triple = "assigner"
+
+; Function Attrs: circuit mustprogress nounwind
+define dso_local noundef i32 @_Z24prover_index_out_of_rangeii(i32 noundef %a, i32 noundef %b) local_unnamed_addr #0 {
+entry:
+  %add = add i32 %a, %b, !zk_multi_prover !3
+  ret i32 %add
+}
+
+attributes #0 = { circuit mustprogress nounwind "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" }
+
+!llvm.linker.options = !{}
+!llvm.module.flags = !{!0, !1}
+!llvm.ident = !{!2}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 7, !"frame-pointer", i32 2}
+!2 = !{!"clang version 16.0.0 (git@github.com:NilFoundation/zkllvm-circifier.git 8d79290301f85623f70c3b4ee874ac5687ef78ed)"}
+!3 = !{!"4294967296"}
@@ -0,0 +1,31 @@
+target datalayout = "e-m:e-p:64:64-i64:64-i128:128-n32:64-S128"
+target triple = "assigner"
+
+; Function Attrs: circuit mustprogress nounwind
+define dso_local noundef i32 @_Z19witness_only_branchii(i32 noundef %a, i32 noundef %b) local_unnamed_addr #0 {
+entry:
+  %cmp = icmp eq i32 %a, 0
+  br i1 %cmp, label %if.then, label %if.else
+
+if.then:
+  %add = add i32 %b, 1
+  br label %return
+
+if.else:
+  %mul = mul i32 %b, %b
+  br label %return
+
+return:
+  %retval = phi i32 [ %add, %if.then ], [ %mul, %if.else ]
+  ret i32 %retval
+}
+
+attributes #0 = { circuit mustprogress nounwind "frame-pointer"="all" "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" }
+
+!llvm.linker.options = !{}
+!llvm.module.flags = !{!0, !1}
+!llvm.ident = !{!2}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 7, !"frame-pointer", i32 2}
+!2 = !{!"clang version 16.0.0 (git@github.com:NilFoundation/zkllvm-circifier.git 8d79290301f85623f70c3b4ee874ac5687ef78ed)"}
@@ -0,0 +1,64 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_estimation_test
+
+#include <string>
+
+#include <boost/json.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <nil/blueprint/test/tables.hpp>
+
+using namespace nil::blueprint;
+
+BOOST_AUTO_TEST_SUITE(assigner_estimation_test_suite)
+
+// The estimate must predict the size of the tables a full run on the same input builds
+BOOST_AUTO_TEST_CASE(estimate_matches_full_run) {
+    const std::string ir_file = test::data_path("witness_only_branch.ll");
+    boost::json::array input = boost::json::parse(R"([{"int": 1}, {"int": 5}])").as_array();
+
+    test::assigner_type estimating_assigner(test::stack_size, false, 1);
+    auto estimating_module = estimating_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(estimating_module != nullptr);
+    cost_report report;
+    BOOST_REQUIRE(estimating_assigner.estimate(*estimating_module, input, report));
+
+    test::assigner_type full_assigner(test::stack_size, false, 1);
+    auto full_module = full_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(full_module != nullptr);
+    BOOST_REQUIRE(full_assigner.evaluate(*full_module, input));
+
+    BOOST_CHECK_EQUAL(report.rows_amount, full_assigner.get_circuit_template().rows_amount);
+    BOOST_CHECK(report.padded_rows_amount >= report.rows_amount);
+    BOOST_REQUIRE_EQUAL(report.provers.size(), full_assigner.assignments.size());
+    BOOST_CHECK_EQUAL(report.provers[0].rows, full_assigner.assignments[0].get_used_rows().size());
+    BOOST_CHECK_EQUAL(report.provers[0].gates, full_assigner.circuits[0].get_used_gates().size());
+    BOOST_CHECK_EQUAL(report.provers[0].copy_constraints,
+                      full_assigner.circuits[0].get_used_copy_constraints().size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
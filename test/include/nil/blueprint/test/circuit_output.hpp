@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_TEST_CIRCUIT_OUTPUT_HPP
+#define CRYPTO3_ASSIGNER_TEST_CIRCUIT_OUTPUT_HPP
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <nil/blueprint/test/tables.hpp>
+
+namespace nil {
+    namespace blueprint {
+        namespace test {
+            using printing_assigner_type = parser<field_type, arithmetization_params, true>;
+
+            // Collects what is printed to std::cout while it is alive, the circuit output among it
+            class output_capture {
+            public:
+                output_capture() : saved(std::cout.rdbuf(buffer.rdbuf())) {
+                }
+
+                ~output_capture() {
+                    std::cout.rdbuf(saved);
+                }
+
+                std::string str() const {
+                    return buffer.str();
+                }
+
+            private:
+                std::ostringstream buffer;
+                std::streambuf *saved;
+            };
+        }    // namespace test
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_TEST_CIRCUIT_OUTPUT_HPP
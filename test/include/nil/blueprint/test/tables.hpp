@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ASSIGNER_TEST_TABLES_HPP
+#define CRYPTO3_ASSIGNER_TEST_TABLES_HPP
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/params.hpp>
+
+#include <nil/blueprint/parser.hpp>
+
+namespace nil {
+    namespace blueprint {
+        namespace test {
+            using field_type = crypto3::algebra::curves::pallas::base_field_type;
+            using arithmetization_params = crypto3::zk::snark::plonk_arithmetization_params<15, 1, 5, 35>;
+            using assigner_type = parser<field_type, arithmetization_params, false>;
+            using arithmetization_type = typename assigner_type::ArithmetizationType;
+
+            constexpr long stack_size = 4000000;
+
+            inline std::string data_path(const std::string &name) {
+                return std::string(ASSIGNER_TEST_DATA_DIR) + name;
+            }
+
+            template<typename GetColumnSize, typename GetCell>
+            void check_equal_columns(const char *kind, std::uint32_t columns_amount,
+                                     GetColumnSize &&column_size, GetCell &&cell) {
+                for (std::uint32_t i = 0; i < columns_amount; i++) {
+                    BOOST_CHECK_MESSAGE(column_size(0, i) == column_size(1, i),
+                                        kind << " column " << i << " has a different size");
+                    std::uint32_t rows = std::min(column_size(0, i), column_size(1, i));
+                    for (std::uint32_t j = 0; j < rows; j++) {
+                        if (cell(0, i, j) != cell(1, i, j)) {
+                            BOOST_ERROR(kind << " column " << i << " differs in row " << j);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // Both tables must have the same columns and copy constraints
+            inline void check_equal_tables(const circuit_template<arithmetization_type> &expected,
+                                           const circuit_template<arithmetization_type> &actual) {
+                const assignment<arithmetization_type> *tables[] = {expected.table.get(), actual.table.get()};
+
+                BOOST_REQUIRE_EQUAL(tables[0]->witnesses_amount(), tables[1]->witnesses_amount());
+                check_equal_columns("witness", tables[0]->witnesses_amount(),
+                    [&](int t, std::uint32_t i) { return tables[t]->witness_column_size(i); },
+                    [&](int t, std::uint32_t i, std::uint32_t j) { return tables[t]->witness(i, j); });
+                BOOST_REQUIRE_EQUAL(tables[0]->public_inputs_amount(), tables[1]->public_inputs_amount());
+                check_equal_columns("public input", tables[0]->public_inputs_amount(),
+                    [&](int t, std::uint32_t i) { return tables[t]->public_input_column_size(i); },
+                    [&](int t, std::uint32_t i, std::uint32_t j) { return tables[t]->public_input(i, j); });
+                BOOST_REQUIRE_EQUAL(tables[0]->constants_amount(), tables[1]->constants_amount());
+                check_equal_columns("constant", tables[0]->constants_amount(),
+                    [&](int t, std::uint32_t i) { return tables[t]->constant_column_size(i); },
+                    [&](int t, std::uint32_t i, std::uint32_t j) { return tables[t]->constant(i, j); });
+                BOOST_REQUIRE_EQUAL(tables[0]->selectors_amount(), tables[1]->selectors_amount());
+                check_equal_columns("selector", tables[0]->selectors_amount(),
+                    [&](int t, std::uint32_t i) { return tables[t]->selector_column_size(i); },
+                    [&](int t, std::uint32_t i, std::uint32_t j) { return tables[t]->selector(i, j); });
+
+                BOOST_CHECK_EQUAL(expected.bp->num_gates(), actual.bp->num_gates());
+                BOOST_CHECK(expected.bp->copy_constraints() == actual.bp->copy_constraints());
+            }
+        }    // namespace test
+    }    // namespace blueprint
+}    // namespace nil
+
+#endif    // CRYPTO3_ASSIGNER_TEST_TABLES_HPP
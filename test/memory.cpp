@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_memory_test
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/blueprint/memory.hpp>
+
+using namespace nil::blueprint;
+
+BOOST_AUTO_TEST_SUITE(assigner_memory_test_suite)
+
+BOOST_AUTO_TEST_CASE(heap_i64_store_load) {
+    program_memory<int> memory(16);
+    ptr_type ptr = memory.malloc(32);
+
+    BOOST_CHECK_EQUAL(memory.store_typed(ptr, 42, 8), ptr + 8);
+    BOOST_CHECK_EQUAL(memory.load(ptr), 42);
+    BOOST_CHECK_EQUAL(memory[ptr].size, 8);
+    BOOST_CHECK_EQUAL(memory[ptr + 3].size, 0);
+    BOOST_CHECK_EQUAL(memory[ptr + 3].offset, ptr);
+
+    memory.store_typed(ptr + 8, 43, 8);
+    BOOST_CHECK_EQUAL(memory.load(ptr + 8), 43);
+    BOOST_CHECK_EQUAL(memory.inttoptr(ptr + 3), ptr + 8);
+    BOOST_CHECK_EQUAL(memory.inttoptr(ptr + 8), ptr + 8);
+}
+
+BOOST_AUTO_TEST_CASE(heap_narrow_store_splits_cell) {
+    program_memory<int> memory(16);
+    ptr_type ptr = memory.malloc(16);
+
+    memory.store_typed(ptr, 42, 8);
+    memory.store_typed(ptr, 7, 4);
+    BOOST_CHECK_EQUAL(memory.load(ptr), 7);
+    BOOST_CHECK_EQUAL(memory[ptr].size, 4);
+    BOOST_CHECK_EQUAL(memory[ptr + 4].size, 1);
+    BOOST_CHECK_EQUAL(memory[ptr + 4].offset, ptr + 4);
+}
+
+BOOST_AUTO_TEST_CASE(heap_vector_store_load) {
+    program_memory<int> memory(16);
+    ptr_type ptr = memory.malloc(16);
+
+    ptr_type cur = ptr;
+    for (int i = 0; i < 4; ++i) {
+        cur = memory.store_typed(cur, 100 + i, 4);
+    }
+    cur = ptr;
+    for (int i = 0; i < 4; ++i, cur = memory.next_cell(cur)) {
+        BOOST_CHECK_EQUAL(memory.load(cur), 100 + i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(heap_free_and_reset) {
+    program_memory<int> memory(16);
+    ptr_type ptr = memory.malloc(32);
+    memory.store_typed(ptr, 42, 8);
+    memory.free(ptr);
+
+    ptr_type reused = memory.malloc(32);
+    BOOST_CHECK_EQUAL(reused, ptr);
+    BOOST_CHECK_EQUAL(memory[reused].size, 1);
+    BOOST_CHECK_EQUAL(memory.load(reused), 0);
+    BOOST_CHECK_EQUAL(memory[reused + 3].offset, reused + 3);
+
+    memory.reset();
+    BOOST_CHECK_EQUAL(memory.malloc(8), ptr);
+    BOOST_CHECK_EQUAL(memory[ptr].size, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
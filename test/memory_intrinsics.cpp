@@ -0,0 +1,54 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_memory_intrinsics_test
+
+#include <boost/json.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <nil/blueprint/test/circuit_output.hpp>
+
+using namespace nil::blueprint;
+
+BOOST_AUTO_TEST_SUITE(assigner_memory_intrinsics_test_suite)
+
+// memcpy through a byte array, an overlapping memmove and a non-zero memset
+BOOST_AUTO_TEST_CASE(copy_move_and_fill) {
+    test::printing_assigner_type assigner(test::stack_size, false, 1);
+    auto module = assigner.parseIRFile(test::data_path("memory_intrinsics.ll").c_str());
+    BOOST_REQUIRE(module != nullptr);
+    boost::json::array input = boost::json::parse(R"([{"int": 5}, {"int": 7}])").as_array();
+
+    std::string output;
+    {
+        test::output_capture capture;
+        BOOST_REQUIRE(assigner.evaluate(*module, input));
+        output = capture.str();
+    }
+    // dst is {5, 5, 7, 5} after the memmove, the first int of src is 0x01010101 after the memset
+    BOOST_CHECK_EQUAL(output, "16843021\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_number_input_test
+
+#include <cstdint>
+#include <string>
+
+#include <boost/json.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <nil/blueprint/number_parser.hpp>
+#include <nil/blueprint/test/circuit_output.hpp>
+
+using namespace nil::blueprint;
+
+BOOST_AUTO_TEST_SUITE(assigner_number_input_test_suite)
+
+BOOST_AUTO_TEST_CASE(parse_decimal_and_hex) {
+    std::uint64_t number = 0;
+    std::string error;
+    BOOST_CHECK(parse_number("0x1f", number, error));
+    BOOST_CHECK_EQUAL(number, 31);
+    BOOST_CHECK(parse_number("0XfFfFfFfFfFfFfFfF", number, error));
+    BOOST_CHECK_EQUAL(number, UINT64_MAX);
+    BOOST_CHECK(parse_number("0000000000000000000000000042", number, error));
+    BOOST_CHECK_EQUAL(number, 42);
+    BOOST_CHECK(parse_number("1234567890123456789", number, error));
+    BOOST_CHECK_EQUAL(number, 1234567890123456789ull);
+    BOOST_CHECK(!parse_number("0x", number, error));
+    BOOST_CHECK(!parse_number("12a", number, error));
+    BOOST_CHECK(!parse_number("0x10000000000000000", number, error));
+}
+
+// The same field elements written in decimal and in hex give the same tables
+BOOST_AUTO_TEST_CASE(decimal_and_hex_fields_match) {
+    const std::string ir_file = test::data_path("pallas_native_field_add.ll");
+
+    test::printing_assigner_type decimal_assigner(test::stack_size, false, 1);
+    auto decimal_module = decimal_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(decimal_module != nullptr);
+    boost::json::array decimal_input = boost::json::parse(
+        R"([{"field": "28948022309329048855892746252171976963363056481941560715954676764349967630336"},)"
+        R"( {"field": "31"}])").as_array();
+    std::string output;
+    {
+        test::output_capture capture;
+        BOOST_REQUIRE(decimal_assigner.evaluate(*decimal_module, decimal_input));
+        output = capture.str();
+    }
+    BOOST_CHECK_EQUAL(output, "30\n");
+
+    test::printing_assigner_type hex_assigner(test::stack_size, false, 1);
+    auto hex_module = hex_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(hex_module != nullptr);
+    boost::json::array hex_input = boost::json::parse(
+        R"([{"field": "0x40000000000000000000000000000000224698fc094cf91b992d30ed00000000"}, {"field": "0x1F"}])")
+        .as_array();
+    {
+        test::output_capture capture;
+        BOOST_REQUIRE(hex_assigner.evaluate(*hex_module, hex_input));
+    }
+
+    test::check_equal_tables(decimal_assigner.get_circuit_template(), hex_assigner.get_circuit_template());
+}
+
+BOOST_AUTO_TEST_CASE(field_modulus_is_rejected) {
+    test::assigner_type assigner(test::stack_size, false, 1);
+    auto module = assigner.parseIRFile(test::data_path("pallas_native_field_add.ll").c_str());
+    BOOST_REQUIRE(module != nullptr);
+    boost::json::array input = boost::json::parse(
+        R"([{"field": "0x40000000000000000000000000000000224698fc094cf91b992d30ed00000001"}, {"field": "12"}])")
+        .as_array();
+    BOOST_CHECK(!assigner.evaluate(*module, input));
+    BOOST_CHECK(!assigner.get_input_error().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
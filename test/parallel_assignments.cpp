@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_parallel_assignments_test
+
+#include <string>
+
+#include <boost/json.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <nil/blueprint/test/circuit_output.hpp>
+
+using namespace nil::blueprint;
+
+BOOST_AUTO_TEST_SUITE(assigner_parallel_assignments_test_suite)
+
+// Witnesses generated on the pool must give the same table and used rows as the sequential generation
+BOOST_AUTO_TEST_CASE(threads_match_sequential) {
+    const std::string ir_file = test::data_path("independent_components.ll");
+    boost::json::array input =
+        boost::json::parse(R"([{"field": "3"}, {"field": "5"}, {"field": "7"}])").as_array();
+
+    test::printing_assigner_type sequential_assigner(test::stack_size, false, 1);
+    auto sequential_module = sequential_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(sequential_module != nullptr);
+    std::string sequential_output;
+    {
+        test::output_capture capture;
+        BOOST_REQUIRE(sequential_assigner.evaluate(*sequential_module, input));
+        sequential_output = capture.str();
+    }
+    // (3 * 5 + 5 * 7 + 3 * 7 - 2 * 3) * 7
+    BOOST_CHECK_EQUAL(sequential_output, "455\n");
+
+    test::printing_assigner_type parallel_assigner(test::stack_size, false, 1);
+    parallel_assigner.set_assignment_threads(4);
+    auto parallel_module = parallel_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(parallel_module != nullptr);
+    std::string parallel_output;
+    {
+        test::output_capture capture;
+        BOOST_REQUIRE(parallel_assigner.evaluate(*parallel_module, input));
+        parallel_output = capture.str();
+    }
+    BOOST_CHECK_EQUAL(parallel_output, sequential_output);
+
+    test::check_equal_tables(sequential_assigner.get_circuit_template(), parallel_assigner.get_circuit_template());
+    BOOST_REQUIRE_EQUAL(sequential_assigner.assignments.size(), parallel_assigner.assignments.size());
+    BOOST_CHECK(sequential_assigner.assignments[0].get_used_rows() == parallel_assigner.assignments[0].get_used_rows());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_pre_optimization_test
+
+#include <string>
+
+#include <boost/json.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <nil/blueprint/test/circuit_output.hpp>
+
+using namespace nil::blueprint;
+
+namespace {
+    const char *entry_name = "_Z16pre_optimizationll";
+
+    std::string function_text(const llvm::Module &module, const char *name) {
+        std::string text;
+        llvm::raw_string_ostream stream(text);
+        module.getFunction(name)->print(stream);
+        return stream.str();
+    }
+
+    std::string evaluate(test::printing_assigner_type &assigner, const llvm::Module &module) {
+        boost::json::array input = boost::json::parse(R"([{"int": 1}, {"int": 2}])").as_array();
+        test::output_capture capture;
+        BOOST_REQUIRE(assigner.evaluate(module, input));
+        return capture.str();
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(assigner_pre_optimization_test_suite)
+
+// The entry point switches provers and repeats a computation of the first prover on the second one,
+// the helper it calls reads a global through a stack slot
+BOOST_AUTO_TEST_CASE(multi_prover_module_with_global_geps) {
+    const std::string ir_file = test::data_path("pre_optimization.ll");
+
+    test::printing_assigner_type plain_assigner(test::stack_size, false, 2);
+    auto plain_module = plain_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(plain_module != nullptr);
+
+    test::printing_assigner_type optimized_assigner(test::stack_size, false, 2);
+    optimized_assigner.set_pre_optimization(true);
+    auto optimized_module = optimized_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(optimized_module != nullptr);
+
+    BOOST_CHECK_EQUAL(function_text(*plain_module, entry_name), function_text(*optimized_module, entry_name));
+
+    // The stack slot is promoted and the GEP of the helper is folded into a constant expression
+    const llvm::Function *helper = optimized_module->getFunction("_Z6middlev");
+    const llvm::LoadInst *load = nullptr;
+    for (const llvm::Instruction &inst : llvm::instructions(*helper)) {
+        BOOST_CHECK(!llvm::isa<llvm::AllocaInst>(inst));
+        if (auto *helper_load = llvm::dyn_cast<llvm::LoadInst>(&inst)) {
+            load = helper_load;
+        }
+    }
+    BOOST_REQUIRE(load != nullptr);
+    BOOST_CHECK(llvm::isa<llvm::ConstantExpr>(load->getPointerOperand()));
+
+    BOOST_CHECK_EQUAL(evaluate(plain_assigner, *plain_module), "19\n");
+    BOOST_CHECK_EQUAL(evaluate(optimized_assigner, *optimized_module), "19\n");
+    BOOST_CHECK_EQUAL(optimized_assigner.assignments.size(), plain_assigner.assignments.size());
+    BOOST_CHECK_EQUAL(optimized_assigner.assignments.size(), std::size_t(2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
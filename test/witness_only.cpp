@@ -0,0 +1,84 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2023 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2023 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE assigner_witness_only_test
+
+#include <string>
+
+#include <boost/json.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <nil/blueprint/test/tables.hpp>
+
+using namespace nil::blueprint;
+
+namespace {
+    boost::json::array branch_input(int a, int b) {
+        return boost::json::array {boost::json::object {{"int", a}}, boost::json::object {{"int", b}}};
+    }
+}    // namespace
+
+BOOST_AUTO_TEST_SUITE(assigner_witness_only_test_suite)
+
+// A witness-only run on the circuit of another input fills the same table as a full run
+BOOST_AUTO_TEST_CASE(witness_only_matches_full_run) {
+    const std::string ir_file = test::data_path("witness_only_branch.ll");
+
+    test::assigner_type template_assigner(test::stack_size, false, 1);
+    auto template_module = template_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(template_module != nullptr);
+    BOOST_REQUIRE(template_assigner.evaluate(*template_module, branch_input(0, 3)));
+    auto cached = template_assigner.get_circuit_template();
+
+    test::assigner_type full_assigner(test::stack_size, false, 1);
+    auto full_module = full_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(full_module != nullptr);
+    BOOST_REQUIRE(full_assigner.evaluate(*full_module, branch_input(0, 5)));
+
+    test::assigner_type witness_assigner(test::stack_size, false, 1);
+    witness_assigner.set_circuit_template(cached);
+    auto witness_module = witness_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(witness_module != nullptr);
+    BOOST_REQUIRE(witness_assigner.evaluate(*witness_module, branch_input(0, 5)));
+
+    test::check_equal_tables(full_assigner.get_circuit_template(), witness_assigner.get_circuit_template());
+}
+
+BOOST_AUTO_TEST_CASE(different_control_flow_is_rejected) {
+    const std::string ir_file = test::data_path("witness_only_branch.ll");
+
+    test::assigner_type template_assigner(test::stack_size, false, 1);
+    auto template_module = template_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(template_module != nullptr);
+    BOOST_REQUIRE(template_assigner.evaluate(*template_module, branch_input(0, 3)));
+
+    test::assigner_type witness_assigner(test::stack_size, false, 1);
+    witness_assigner.set_circuit_template(template_assigner.get_circuit_template());
+    auto witness_module = witness_assigner.parseIRFile(ir_file.c_str());
+    BOOST_REQUIRE(witness_module != nullptr);
+    BOOST_CHECK(!witness_assigner.evaluate(*witness_module, branch_input(1, 5)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()